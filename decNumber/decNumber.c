@@ -3929,8 +3929,11 @@ static decNumber * decAddOp(decNumber *res, const decNumber *lhs,
 
       // If, after pad, rhs would be longer than lhs by digits+1 or
       // more then lhs cannot affect the answer, except as a residue,
-      // so only need to pad up to a length of DIGITS+1.
-      if (rhs->digits+padding > lhs->digits+reqdigits+1) {
+      // so only need to pad up to a length of DIGITS+1.  When the
+      // rhs is itself longer than DIGITS (as an fma product may be)
+      // the lhs must also lie wholly below its lowest digit.
+      if (rhs->digits+padding > lhs->digits+reqdigits+1
+       && lhs->digits<=padding) {
         // The RHS is sufficient
         // for residue use the relative sign indication...
         Int shift=reqdigits-rhs->digits;     // left shift needed
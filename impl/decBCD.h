@@ -0,0 +1,221 @@
+/* ------------------------------------------------------------------ */
+/* decBCD.h header                                                    */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+// Helpers shared by the record field codecs (<decpacked>, <deczoned>)
+// and the formatter (<decformat>).
+// A coefficient is handled as 12-bit BCD groups of three digits, least
+// significant first, which map one to one onto the declets of the DPD
+// encodings.
+
+#ifndef _DECBCD_H
+#define _DECBCD_H
+
+#include "impl/decNative.h"
+
+// BCD <-> DPD declet tables (internal to each including file)
+#define DEC_BCD2DPD 1
+#define DEC_DPD2BCD 1
+#include "decDPD.h"
+
+// _GroupsToNumber and _NumberToGroups move a group to a unit of a
+// decNumber as it is
+#if DECDPUN != 3
+#error "impl/decBCD.h requires DECDPUN == 3"
+#endif
+
+namespace std {
+namespace decimal {
+
+// 12-bit BCD groups of the longest field of any codec (45 digits)
+static const int _MaxGroups = 15;
+
+// parameters of the direct conversions
+template <class _Fmt> struct _BCDFmt;
+
+template <> struct _BCDFmt<decimal32> {
+        static const int _Declets = 2;
+        static const int _Bias = 101;
+        static const int _ExpCont = 6;
+};
+
+template <> struct _BCDFmt<decimal64> {
+        static const int _Declets = 5;
+        static const int _Bias = 398;
+        static const int _ExpCont = 8;
+};
+
+template <> struct _BCDFmt<decimal128> {
+        static const int _Declets = 11;
+        static const int _Bias = 6176;
+        static const int _ExpCont = 12;
+};
+
+// builds a finite value from its sign, most significant digit,
+// biased exponent and declets
+inline void _Assemble(decimal64 & _V, unsigned _Sign, unsigned _Msd,
+                      unsigned _E, const unsigned * _Dec)
+        {
+        const unsigned _Comb = _EncodeComb(_Msd, _E >> 8);
+        uint64_t _W = (static_cast<uint64_t>(_Sign) << 63) |
+                      (static_cast<uint64_t>(_Comb) << 58) |
+                      (static_cast<uint64_t>(_E & 0xFF) << 50);
+        for (int _I = 0; _I != 5; ++_I)
+                { _W |= static_cast<uint64_t>(_Dec[_I]) << (10 * _I); }
+#if defined(_DEC_DECIMAL64_BID)
+        _Native64 _N;
+        _UnpackDPD<_Layout64>(_W, _N);
+        _Pack(_V, _N);
+#else
+        _SetWord(_V, _W);
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+inline void _Assemble(decimal128 & _V, unsigned _Sign, unsigned _Msd,
+                      unsigned _E, const unsigned * _Dec)
+        {
+        _Uint128 _W = _MakeUint128(
+                (static_cast<uint64_t>(_Sign) << 63) |
+                (static_cast<uint64_t>(_EncodeComb(_Msd, _E >> 12)) << 58) |
+                (static_cast<uint64_t>(_E & 0xFFF) << 46), 0);
+        for (int _I = 0; _I != 11; ++_I)
+                { _OrDeclet128(_W, _I, _Dec[_I]); }
+        _SetWord(_V, _W);
+        }
+
+// Splits a finite value into its sign, exponent and 12-bit BCD groups
+// (the last being the most significant digit).  Returns false for an
+// infinity or NaN.
+inline bool _Disassemble(const decimal32 & _V, unsigned & _Sign, int & _Exp,
+                         unsigned * _G)
+        {
+        const uint32_t _W = _GetWord(_V);
+        const unsigned _Comb = (_W >> 26) & 0x1F;
+        if (_Comb >= 0x1E)
+                { return false; }
+
+        unsigned _Msd, _ExpHi;
+        _DecodeComb(_Comb, _Msd, _ExpHi);
+        _Sign = _W >> 31;
+        _Exp = static_cast<int>((_ExpHi << 6) | ((_W >> 20) & 0x3F)) - 101;
+        _G[0] = DPD2BCD[_W & 0x3FF];
+        _G[1] = DPD2BCD[(_W >> 10) & 0x3FF];
+        _G[2] = _Msd;
+        return true;
+        }
+
+inline bool _Disassemble(const decimal64 & _V, unsigned & _Sign, int & _Exp,
+                         unsigned * _G)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _Native64 _N;
+        _Unpack(_V, _N);
+        if (_N._Kind != _NativeFinite)
+                { return false; }
+        const uint64_t _W = _PackDPD<_Layout64>(_N);
+#else
+        const uint64_t _W = _GetWord(_V);
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        const unsigned _Comb = static_cast<unsigned>(_W >> 58) & 0x1F;
+        if (_Comb >= 0x1E)
+                { return false; }
+
+        unsigned _Msd, _ExpHi;
+        _DecodeComb(_Comb, _Msd, _ExpHi);
+        _Sign = static_cast<unsigned>(_W >> 63);
+        const unsigned _ExpLo = static_cast<unsigned>(_W >> 50) & 0xFF;
+        _Exp = static_cast<int>((_ExpHi << 8) | _ExpLo) - 398;
+        for (int _I = 0; _I != 5; ++_I)
+                {
+                _G[_I] = DPD2BCD[static_cast<unsigned>(_W >> (10 * _I)) &
+                                 0x3FF];
+                }
+        _G[5] = _Msd;
+        return true;
+        }
+
+inline bool _Disassemble(const decimal128 & _V, unsigned & _Sign, int & _Exp,
+                         unsigned * _G)
+        {
+        const _Uint128 _W = _GetWord(_V);
+        const unsigned _Comb = static_cast<unsigned>(_W._Hi >> 58) & 0x1F;
+        if (_Comb >= 0x1E)
+                { return false; }
+
+        unsigned _Msd, _ExpHi;
+        _DecodeComb(_Comb, _Msd, _ExpHi);
+        _Sign = static_cast<unsigned>(_W._Hi >> 63);
+        const unsigned _ExpLo = static_cast<unsigned>(_W._Hi >> 46) & 0xFFF;
+        _Exp = static_cast<int>((_ExpHi << 12) | _ExpLo) - 6176;
+        for (int _I = 0; _I != 11; ++_I)
+                { _G[_I] = DPD2BCD[_Declet128(_W, _I)]; }
+        _G[11] = _Msd;
+        return true;
+        }
+
+// the number of significant digits in the _NG groups of _G
+inline std::size_t _SigDigits(const unsigned * _G, int _NG)
+        {
+        for (int _K = _NG - 1; _K >= 0; --_K)
+                {
+                if (_G[_K] != 0)
+                        {
+                        return 3 * _K + (_G[_K] > 0xFF ? 3 :
+                                         _G[_K] > 0xF ? 2 : 1);
+                        }
+                }
+        return 0;
+        }
+
+// loads the _NG groups of _G into a decNumber
+inline void _GroupsToNumber(const unsigned * _G, int _NG, unsigned _Sign,
+                            int _Exp, _DecNumber & _N)
+        {
+        const std::size_t _Sig = _SigDigits(_G, _NG);
+        _N.bits = _Sign ? DECNEG : 0;
+        _N.exponent = _Exp;
+        _N.digits = _Sig != 0 ? static_cast<int32_t>(_Sig) : 1;
+        _N.lsu[0] = 0;
+        for (std::size_t _K = 0; 3 * _K < _Sig; ++_K)
+                {
+                const unsigned _B = _G[_K];
+                _N.lsu[_K] = static_cast<decNumberUnit>(
+                        (_B >> 8) * 100 + ((_B >> 4) & 0xF) * 10 + (_B & 0xF));
+                }
+        }
+
+// Stores the coefficient of a finite decNumber in the _NG groups of
+// _G.  Returns false if it has more digits than the groups can hold.
+inline bool _NumberToGroups(const _DecNumber & _N, unsigned * _G, int _NG)
+        {
+        if (_N.digits > 3 * _NG)
+                { return false; }
+        for (int _K = 0; _K != _NG; ++_K)
+                {
+                if (3 * _K >= _N.digits)
+                        {
+                        _G[_K] = 0;
+                        continue;
+                        }
+                const unsigned _U = _N.lsu[_K];
+                _G[_K] = ((_U / 100) << 8) | (((_U / 10) % 10) << 4) |
+                         (_U % 10);
+                }
+        return true;
+        }
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECBCD_H */
@@ -0,0 +1,284 @@
+/* ------------------------------------------------------------------ */
+/* decBID.cpp source file                                             */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "decbid"
+#include "impl/decNative.h"
+#include "impl/decSimd.h"
+
+namespace std {
+namespace decimal {
+
+static inline _Uint128 _Load128(const uint64_t * _P)
+        {
+#if defined(_DEC_BIG_ENDIAN)
+        return _MakeUint128(_P[0], _P[1]);
+#else
+        return _MakeUint128(_P[1], _P[0]);
+#endif /* defined(_DEC_BIG_ENDIAN) */
+        }
+
+static inline void _Store128(uint64_t * _P, const _Uint128 & _W)
+        {
+#if defined(_DEC_BIG_ENDIAN)
+        _P[0] = _W._Hi;
+        _P[1] = _W._Lo;
+#else
+        _P[0] = _W._Lo;
+        _P[1] = _W._Hi;
+#endif /* defined(_DEC_BIG_ENDIAN) */
+        }
+
+template <class _L>
+static void _DPDToBID(const typename _L::_Word * _In,
+                      std::size_t _Count,
+                      typename _L::_Word * _Out)
+        {
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _UnpackDPD<_L>(_In[_I], _N);
+                _Out[_I] = _PackBID<_L>(_N);
+                }
+        }
+
+template <class _L>
+static void _BIDToDPD(const typename _L::_Word * _In,
+                      std::size_t _Count,
+                      typename _L::_Word * _Out)
+        {
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _UnpackBID<_L>(_In[_I], _N);
+                _Out[_I] = _PackDPD<_L>(_N);
+                }
+        }
+
+// The 64-bit conversion from DPD, a block of 64 values at a time: the
+// declets are decoded by the _Decode kernel of decSimd.h, and each block
+// is read before it is written, so _In may be _Out.  The conversion to
+// DPD packs one value at a time, as the _Encode kernel, which looks up
+// BIN2DPD with gathers, is no faster than _PackDPD.
+static void _DPDToBID64(const uint64_t * _In, std::size_t _Count,
+                        uint64_t * _Out)
+        {
+        const _SimdKernels & _K = _GetSimdKernels();
+        uint64_t _Coeffs[64];
+        int16_t _Exps[64];
+        for (std::size_t _B = 0; _B < _Count; _B += 64)
+                {
+                const int _N = _Count - _B < 64 ?
+                               static_cast<int>(_Count - _B) : 64;
+                uint64_t _Signs;
+                const uint64_t _Specials =
+                        _K._Decode(_In + _B, _N, _Coeffs, _Exps, _Signs);
+                for (int _I = 0; _I != _N; ++_I)
+                        {
+                        _Native64 _V;
+                        _V._Sign = static_cast<unsigned>(_Signs >> _I & 1);
+                        if ((_Specials >> _I & 1) != 0)
+                                {
+                                _V._Kind =
+                                        static_cast<_NativeKind>(_Exps[_I]);
+                                _V._Exp = 0;
+                                }
+                        else
+                                {
+                                _V._Kind = _NativeFinite;
+                                _V._Exp = _Exps[_I];
+                                }
+                        _V._Coeff = _Coeffs[_I];
+                        _Out[_B + _I] = _PackBID<_Layout64>(_V);
+                        }
+                }
+        }
+
+#if defined(_DEC_DECIMAL64_BID)
+
+// decimal64 values from DPD encodings, through a buffer of 64 words
+static void _FromDPD64(const uint64_t * _In, std::size_t _Count,
+                       decimal64 * _Out)
+        {
+        uint64_t _Words[64];
+        for (std::size_t _B = 0; _B < _Count; _B += 64)
+                {
+                const std::size_t _N = _Count - _B < 64 ? _Count - _B : 64;
+                _DPDToBID64(_In + _B, _N, _Words);
+                for (std::size_t _I = 0; _I != _N; ++_I)
+                        { _SetWord(_Out[_B + _I], _Words[_I]); }
+                }
+        }
+
+#else
+
+// the BID encodings of decimal64 values, converted in place in _Out
+static void _ToBID64(const decimal64 * _In, std::size_t _Count,
+                     uint64_t * _Out)
+        {
+        for (std::size_t _B = 0; _B < _Count; _B += 64)
+                {
+                const std::size_t _N = _Count - _B < 64 ? _Count - _B : 64;
+                for (std::size_t _I = 0; _I != _N; ++_I)
+                        { _Out[_B + _I] = _GetWord(_In[_B + _I]); }
+                _DPDToBID64(_Out + _B, _N, _Out + _B);
+                }
+        }
+
+#endif /* defined(_DEC_DECIMAL64_BID) */
+
+void dpd_to_bid32(const uint32_t * _In, std::size_t _Count, uint32_t * _Out)
+        { _DPDToBID<_Layout32>(_In, _Count, _Out); }
+
+void bid_to_dpd32(const uint32_t * _In, std::size_t _Count, uint32_t * _Out)
+        { _BIDToDPD<_Layout32>(_In, _Count, _Out); }
+
+void dpd_to_bid64(const uint64_t * _In, std::size_t _Count, uint64_t * _Out)
+        { _DPDToBID64(_In, _Count, _Out); }
+
+void bid_to_dpd64(const uint64_t * _In, std::size_t _Count, uint64_t * _Out)
+        { _BIDToDPD<_Layout64>(_In, _Count, _Out); }
+
+void dpd_to_bid128(const uint64_t * _In, std::size_t _Count, uint64_t * _Out)
+        {
+        _Native128 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += 2, _Out += 2)
+                {
+                _UnpackDPD128(_Load128(_In), _N);
+                _Store128(_Out, _PackBID128(_N));
+                }
+        }
+
+void bid_to_dpd128(const uint64_t * _In, std::size_t _Count, uint64_t * _Out)
+        {
+        _Native128 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += 2, _Out += 2)
+                {
+                _UnpackBID128(_Load128(_In), _N);
+                _Store128(_Out, _PackDPD128(_N));
+                }
+        }
+
+void to_bid(const decimal32 * _In, std::size_t _Count, uint32_t * _Out)
+        {
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _Unpack(_In[_I], _N);
+                _Out[_I] = _PackBID<_Layout32>(_N);
+                }
+        }
+
+void to_bid(const decimal64 * _In, std::size_t _Count, uint64_t * _Out)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Out[_I] = _GetWord(_In[_I]); }
+#else
+        _ToBID64(_In, _Count, _Out);
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+void to_bid(const decimal128 * _In, std::size_t _Count, uint64_t * _Out)
+        {
+        _Native128 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I, _Out += 2)
+                {
+                _Unpack(_In[_I], _N);
+                _Store128(_Out, _PackBID128(_N));
+                }
+        }
+
+void from_bid(const uint32_t * _In, std::size_t _Count, decimal32 * _Out)
+        {
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _UnpackBID<_Layout32>(_In[_I], _N);
+                _Pack(_Out[_I], _N);
+                }
+        }
+
+void from_bid(const uint64_t * _In, std::size_t _Count, decimal64 * _Out)
+        {
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                // canonicalizes the encoding in either storage mode
+                _UnpackBID<_Layout64>(_In[_I], _N);
+                _Pack(_Out[_I], _N);
+                }
+        }
+
+void from_bid(const uint64_t * _In, std::size_t _Count, decimal128 * _Out)
+        {
+        _Native128 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += 2)
+                {
+                _UnpackBID128(_Load128(_In), _N);
+                _Pack(_Out[_I], _N);
+                }
+        }
+
+void to_dpd(const decimal32 * _In, std::size_t _Count, uint32_t * _Out)
+        {
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Out[_I] = _GetWord(_In[_I]); }
+        }
+
+void to_dpd(const decimal64 * _In, std::size_t _Count, uint64_t * _Out)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _Native64 _N;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _Unpack(_In[_I], _N);
+                _Out[_I] = _PackDPD<_Layout64>(_N);
+                }
+#else
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Out[_I] = _GetWord(_In[_I]); }
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+void to_dpd(const decimal128 * _In, std::size_t _Count, uint64_t * _Out)
+        {
+        for (std::size_t _I = 0; _I != _Count; ++_I, _Out += 2)
+                { _Store128(_Out, _GetWord(_In[_I])); }
+        }
+
+void from_dpd(const uint32_t * _In, std::size_t _Count, decimal32 * _Out)
+        {
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _SetWord(_Out[_I], _In[_I]); }
+        }
+
+void from_dpd(const uint64_t * _In, std::size_t _Count, decimal64 * _Out)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _FromDPD64(_In, _Count, _Out);
+#else
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _SetWord(_Out[_I], _In[_I]); }
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+void from_dpd(const uint64_t * _In, std::size_t _Count, decimal128 * _Out)
+        {
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += 2)
+                { _SetWord(_Out[_I], _Load128(_In)); }
+        }
+
+} // namespace decimal
+} // namespace std
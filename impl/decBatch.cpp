@@ -0,0 +1,259 @@
+/* ------------------------------------------------------------------ */
+/* decBatch.cpp source file                                           */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "decbatch"
+#include "impl/decKernel.h"
+
+namespace std {
+namespace decimal {
+
+// The operations: _Fast computes the result from the unpacked operands,
+// which are finite, when a kernel can, and _Slow through decNumber.
+struct _BatchAdd {
+        template <class _M>
+        static bool _Fast(const typename _M::_Native & _X,
+                          const typename _M::_Native & _Y, rounding _Mode,
+                          typename _M::_Native & _R, uint32_t &)
+                {
+                return _KernelAdd<_M>(_X._Sign, _X._Coeff, _X._Exp,
+                                      _Y._Sign, _Y._Coeff, _Y._Exp, 0,
+                                      _Mode, _R._Sign, _R._Coeff, _R._Exp);
+                }
+        static void _Slow(_DecNumber & _R, const _DecNumber & _X,
+                          const _DecNumber & _Y, ::decContext * _Context)
+                { decNumberAdd(&_R, &_X, &_Y, _Context); }
+};
+
+struct _BatchSub {
+        template <class _M>
+        static bool _Fast(const typename _M::_Native & _X,
+                          const typename _M::_Native & _Y, rounding _Mode,
+                          typename _M::_Native & _R, uint32_t &)
+                {
+                return _KernelAdd<_M>(_X._Sign, _X._Coeff, _X._Exp,
+                                      _Y._Sign, _Y._Coeff, _Y._Exp, 1,
+                                      _Mode, _R._Sign, _R._Coeff, _R._Exp);
+                }
+        static void _Slow(_DecNumber & _R, const _DecNumber & _X,
+                          const _DecNumber & _Y, ::decContext * _Context)
+                { decNumberSubtract(&_R, &_X, &_Y, _Context); }
+};
+
+struct _BatchMul {
+        template <class _M>
+        static bool _Fast(const typename _M::_Native & _X,
+                          const typename _M::_Native & _Y, rounding,
+                          typename _M::_Native & _R, uint32_t &)
+                {
+                return _KernelMul<_M>(_X._Sign, _X._Coeff, _X._Exp,
+                                      _Y._Sign, _Y._Coeff, _Y._Exp,
+                                      _R._Sign, _R._Coeff, _R._Exp);
+                }
+        static void _Slow(_DecNumber & _R, const _DecNumber & _X,
+                          const _DecNumber & _Y, ::decContext * _Context)
+                { decNumberMultiply(&_R, &_X, &_Y, _Context); }
+};
+
+struct _BatchDiv {
+        template <class _M>
+        static bool _Fast(const typename _M::_Native & _X,
+                          const typename _M::_Native & _Y, rounding,
+                          typename _M::_Native & _R, uint32_t &)
+                {
+                return _KernelDiv<_M>(_X._Sign, _X._Coeff, _X._Exp,
+                                      _Y._Sign, _Y._Coeff, _Y._Exp,
+                                      _R._Sign, _R._Coeff, _R._Exp);
+                }
+        static void _Slow(_DecNumber & _R, const _DecNumber & _X,
+                          const _DecNumber & _Y, ::decContext * _Context)
+                { decNumberDivide(&_R, &_X, &_Y, _Context); }
+};
+
+struct _BatchQuantize {
+        template <class _M>
+        static bool _Fast(const typename _M::_Native & _X,
+                          const typename _M::_Native & _Y, rounding _Mode,
+                          typename _M::_Native & _R, uint32_t & _Status)
+                {
+                _R._Sign = _X._Sign;
+                _R._Exp = _Y._Exp;
+                return _KernelQuantize<_M>(_X._Sign, _X._Coeff, _X._Exp,
+                                           _Y._Exp, _Mode, _R._Coeff,
+                                           _Status);
+                }
+        static void _Slow(_DecNumber & _R, const _DecNumber & _X,
+                          const _DecNumber & _Y, ::decContext * _Context)
+                { decNumberQuantize(&_R, &_X, &_Y, _Context); }
+};
+
+// _Out[_I] = _A[_I * _StepA] op _B[_I * _StepB], with a step of zero
+// for a scalar operand.
+template <class _Op, class _Dec>
+static uint32_t _Batch(const _Dec * _A, std::size_t _StepA,
+                       const _Dec * _B, std::size_t _StepB,
+                       _Dec * _Out, std::size_t _Count)
+        {
+        typedef _KernelFmt<_Dec> _M;
+        typename _M::_Tr::_Context _Ctxt(false);
+        const typename _M::_Native _Zero = typename _M::_Native();
+        typename _M::_Native _X = _Zero, _Y = _Zero, _R = _Zero;
+        _R._Kind = _NativeFinite;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                const _Dec & _L = _A[_I * _StepA];
+                const _Dec & _Rhs = _B[_I * _StepB];
+                if (_StepA != 0 || _I == 0)
+                        { _Unpack(_L, _X); }
+                if (_StepB != 0 || _I == 0)
+                        { _Unpack(_Rhs, _Y); }
+
+                uint32_t _Status = 0;
+                if (_X._Kind == _NativeFinite && _Y._Kind == _NativeFinite &&
+                    _Op::template _Fast<_M>(_X, _Y, _Ctxt.round, _R, _Status))
+                        {
+                        _Pack(_Out[_I], _R);
+                        _Ctxt.status |= _Status;
+                        continue;
+                        }
+
+                _DecNumber _Tmp;
+                _Op::_Slow(_Tmp, _DecNumber(_L), _DecNumber(_Rhs), &_Ctxt);
+                _M::_Tr::_FromNumber(&_Out[_I], _Tmp, &_Ctxt);
+                }
+        return _Ctxt.status;
+        }
+
+uint32_t add(const decimal64 * _A, const decimal64 * _B,
+             decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t add(const decimal64 * _A, decimal64 _B,
+             decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t add(decimal64 _A, const decimal64 * _B,
+             decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t add(const decimal128 * _A, const decimal128 * _B,
+             decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t add(const decimal128 * _A, decimal128 _B,
+             decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t add(decimal128 _A, const decimal128 * _B,
+             decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchAdd>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t subtract(const decimal64 * _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t subtract(const decimal64 * _A, decimal64 _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t subtract(decimal64 _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t subtract(const decimal128 * _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t subtract(const decimal128 * _A, decimal128 _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t subtract(decimal128 _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchSub>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t multiply(const decimal64 * _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t multiply(const decimal64 * _A, decimal64 _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t multiply(decimal64 _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t multiply(const decimal128 * _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t multiply(const decimal128 * _A, decimal128 _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t multiply(decimal128 _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchMul>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t divide(const decimal64 * _A, const decimal64 * _B,
+                decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t divide(const decimal64 * _A, decimal64 _B,
+                decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t divide(decimal64 _A, const decimal64 * _B,
+                decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t divide(const decimal128 * _A, const decimal128 * _B,
+                decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t divide(const decimal128 * _A, decimal128 _B,
+                decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t divide(decimal128 _A, const decimal128 * _B,
+                decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchDiv>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t quantize(const decimal64 * _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t quantize(const decimal64 * _A, decimal64 _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t quantize(decimal64 _A, const decimal64 * _B,
+                  decimal64 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(&_A, 0, _B, 1, _Out, _Count); }
+
+uint32_t quantize(const decimal128 * _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(_A, 1, _B, 1, _Out, _Count); }
+
+uint32_t quantize(const decimal128 * _A, decimal128 _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(_A, 1, &_B, 0, _Out, _Count); }
+
+uint32_t quantize(decimal128 _A, const decimal128 * _B,
+                  decimal128 * _Out, std::size_t _Count)
+        { return _Batch<_BatchQuantize>(&_A, 0, _B, 1, _Out, _Count); }
+
+} // namespace decimal
+} // namespace std
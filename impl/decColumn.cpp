@@ -0,0 +1,533 @@
+/* ------------------------------------------------------------------ */
+/* decColumn.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "deccolumn"
+#include "impl/decKernel.h"
+#include "impl/decSimd.h"
+
+namespace std {
+namespace decimal {
+
+// _In[0], ..., _In[_Count - 1] unpacked one at a time
+template <class _Dec>
+static void _UnpackValues(const _Dec * _In, std::size_t _Count,
+                          typename _ColumnFmt<_Dec>::_Coeff * _Coeffs,
+                          int16_t * _Exps, uint64_t * _Signs,
+                          uint64_t * _Specials)
+        {
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                _Signs[_W] = 0;
+                _Specials[_W] = 0;
+                }
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                typename _ColumnFmt<_Dec>::_Native _N;
+                _Unpack(_In[_I], _N);
+                const uint64_t _Bit = static_cast<uint64_t>(1) << (_I % 64);
+                _Coeffs[_I] = _N._Coeff;
+                _Exps[_I] = static_cast<int16_t>(
+                        _N._Kind == _NativeFinite ? _N._Exp : _N._Kind);
+                if (_N._Sign != 0)
+                        { _Signs[_I / 64] |= _Bit; }
+                if (_N._Kind != _NativeFinite)
+                        { _Specials[_I / 64] |= _Bit; }
+                }
+        }
+
+template <class _Dec>
+static void _PackValues(const typename _ColumnFmt<_Dec>::_Coeff * _Coeffs,
+                        const int16_t * _Exps, const uint64_t * _Signs,
+                        const uint64_t * _Specials, std::size_t _Count,
+                        _Dec * _Out)
+        {
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                typename _ColumnFmt<_Dec>::_Native _N;
+                _N._Sign = static_cast<unsigned>(_Signs[_I / 64] >> (_I % 64)
+                                                 & 1);
+                if ((_Specials[_I / 64] >> (_I % 64) & 1) != 0)
+                        {
+                        _N._Kind = static_cast<_NativeKind>(_Exps[_I]);
+                        _N._Exp = 0;
+                        }
+                else
+                        {
+                        _N._Kind = _NativeFinite;
+                        _N._Exp = _Exps[_I];
+                        }
+                _N._Coeff = _Coeffs[_I];
+                _Pack(_Out[_I], _N);
+                }
+        }
+
+// the shorter of the lengths of two columns
+template <class _Dec>
+static std::size_t _CommonSize(const decimal_column<_Dec> & _A,
+                               const decimal_column<_Dec> & _B)
+        { return _A.size() < _B.size() ? _A.size() : _B.size(); }
+
+// block _W of a decimal64 column, as an operand of the SIMD kernels
+static _SimdOperand _BlockOf(const decimal_column<decimal64> & _X,
+                             std::size_t _W)
+        {
+        _SimdOperand _Op;
+        _Op._Coeff = _X.coefficients() + 64 * _W;
+        _Op._Exp = _X.exponents() + 64 * _W;
+        _Op._Signs = _X.signs()[_W];
+        _Op._Specials = _X.specials()[_W];
+        return _Op;
+        }
+
+// the number of values in block _W of a column of _Count values
+static int _BlockSize(std::size_t _Count, std::size_t _W)
+        {
+        return _Count - 64 * _W < 64 ? static_cast<int>(_Count - 64 * _W) :
+                                       64;
+        }
+
+// Stores the finite values of block _W decided by a kernel, those with
+// bits set in _Done, with the exponents of _Exp and the signs of
+// _Signs.  The others must have been stored already.
+static void _StoreBlock(decimal_column<decimal64> & _Out, std::size_t _W,
+                        uint64_t _Done, const uint64_t * _Coeff,
+                        const int16_t * _Exp, uint64_t _Signs)
+        {
+        uint64_t * const _C = _Out._CoeffData() + 64 * _W;
+        int16_t * const _E = _Out._ExpData() + 64 * _W;
+        if (_Done == ~static_cast<uint64_t>(0))
+                {
+                for (int _I = 0; _I != 64; ++_I)
+                        {
+                        _C[_I] = _Coeff[_I];
+                        _E[_I] = _Exp[_I];
+                        }
+                }
+        else
+                {
+                for (int _I = 0; _I != 64; ++_I)
+                        {
+                        if ((_Done >> _I & 1) != 0)
+                                {
+                                _C[_I] = _Coeff[_I];
+                                _E[_I] = _Exp[_I];
+                                }
+                        }
+                }
+        _Out._SignData()[_W] = (_Out._SignData()[_W] & ~_Done) |
+                               (_Signs & _Done);
+        _Out._SpecialData()[_W] &= ~_Done;
+        }
+
+// Value _I of _A + _B, with the sign of _B inverted if _Neg is 1.  A sum
+// of finite values that is exact and fits the format is computed on the
+// coefficients.
+template <class _Dec>
+static void _AddOne(const decimal_column<_Dec> & _A,
+                    const decimal_column<_Dec> & _B, unsigned _Neg,
+                    std::size_t _I,
+                    typename _KernelFmt<_Dec>::_Tr::_Context & _Ctxt,
+                    decimal_column<_Dec> & _Out)
+        {
+        typedef _KernelFmt<_Dec> _M;
+        unsigned _S;
+        typename _M::_Coeff _C;
+        int _E;
+        if (!_A.is_special(_I) && !_B.is_special(_I) &&
+            _KernelAdd<_M>(_A.sign(_I), _A.coefficient(_I), _A.exponent(_I),
+                           _B.sign(_I), _B.coefficient(_I), _B.exponent(_I),
+                           _Neg, _Ctxt.round, _S, _C, _E))
+                {
+                _Out._SetFinite(_I, _S, _E, _C);
+                return;
+                }
+
+        const _DecNumber _L(_A.get(_I)), _R(_B.get(_I));
+        _Dec _V;
+        _M::_Tr::_FromNumber(&_V, _Neg ?
+                             _DecNumber::_Sub::_Operator(_L, _R, &_Ctxt) :
+                             _DecNumber::_Add::_Operator(_L, _R, &_Ctxt),
+                             &_Ctxt);
+        _Out.set(_I, _V);
+        }
+
+template <class _Dec>
+static uint32_t _AddColumns(const decimal_column<_Dec> & _A,
+                            const decimal_column<_Dec> & _B, unsigned _Neg,
+                            decimal_column<_Dec> & _Out)
+        {
+        typename _KernelFmt<_Dec>::_Tr::_Context _Ctxt(false);
+        const std::size_t _Count = _CommonSize(_A, _B);
+        _Out.resize(_Count);
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _AddOne(_A, _B, _Neg, _I, _Ctxt, _Out); }
+        return _Ctxt.status;
+        }
+
+// decimal64 columns go through the SIMD kernels a block at a time; the
+// values a kernel leaves are done one by one, before the block is
+// stored, so that _Out may be one of the operands.
+static uint32_t _AddColumns(const decimal_column<decimal64> & _A,
+                            const decimal_column<decimal64> & _B,
+                            unsigned _Neg, decimal_column<decimal64> & _Out)
+        {
+        _Context64 _Ctxt(false);
+        const std::size_t _Count = _CommonSize(_A, _B);
+        _Out.resize(_Count);
+        const _SimdKernels & _K = _GetSimdKernels();
+        uint64_t _Coeff[64];
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                const int _N = _BlockSize(_Count, _W);
+                const _SimdOperand _X = _BlockOf(_A, _W);
+                _SimdOperand _Y = _BlockOf(_B, _W);
+                if (_Neg)
+                        { _Y._Signs = ~_Y._Signs; }
+                uint64_t _Signs;
+                const uint64_t _Done = _K._Add(_X, _Y, _N, _Coeff, _Signs);
+                for (int _I = 0; _I != _N; ++_I)
+                        {
+                        if ((_Done >> _I & 1) == 0)
+                                {
+                                _AddOne(_A, _B, _Neg, 64 * _W + _I, _Ctxt,
+                                        _Out);
+                                }
+                        }
+                _StoreBlock(_Out, _W, _Done, _Coeff, _X._Exp, _Signs);
+                }
+        return _Ctxt.status;
+        }
+
+// Compares two values in the form held in a column, where the exponent
+// of a special value is its class.
+template <class _M>
+static int8_t _CompareValues(bool _SpA, unsigned _SA,
+                             const typename _M::_Coeff & _CA, int _EA,
+                             bool _SpB, unsigned _SB,
+                             const typename _M::_Coeff & _CB, int _EB)
+        {
+        if ((_SpA && _EA != _NativeInf) || (_SpB && _EB != _NativeInf))
+                { return 2; }
+        if (_SpA || _SpB)
+                {
+                // -1, 0 and 1 for negative infinity, finite values and
+                // positive infinity
+                const int _RA = _SpA ? (_SA ? -1 : 1) : 0;
+                const int _RB = _SpB ? (_SB ? -1 : 1) : 0;
+                return static_cast<int8_t>(_RA < _RB ? -1 : _RB < _RA ? 1 : 0);
+                }
+
+        const bool _ZA = _M::_IsZero(_CA), _ZB = _M::_IsZero(_CB);
+        if (_ZA && _ZB)
+                { return 0; }
+        if (_ZA)
+                { return _SB ? 1 : -1; }
+        if (_ZB || _SA != _SB)
+                { return _SA ? -1 : 1; }
+        const int _C = _CompareMagnitudes<_M>(_CA, _EA, _CB, _EB);
+        return static_cast<int8_t>(_SA ? -_C : _C);
+        }
+
+// value _I of _A against _B
+template <class _Dec>
+static int8_t _CompareOne(const decimal_column<_Dec> & _A, std::size_t _I,
+                          const decimal_column<_Dec> & _B, std::size_t _J)
+        {
+        return _CompareValues<_KernelFmt<_Dec> >(
+                _A.is_special(_I), _A.sign(_I), _A.coefficient(_I),
+                _A.exponent(_I),
+                _B.is_special(_J), _B.sign(_J), _B.coefficient(_J),
+                _B.exponent(_J));
+        }
+
+template <class _Dec>
+static void _CompareColumns(const decimal_column<_Dec> & _A,
+                            const decimal_column<_Dec> & _B, int8_t * _Out)
+        {
+        const std::size_t _Count = _CommonSize(_A, _B);
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Out[_I] = _CompareOne(_A, _I, _B, _I); }
+        }
+
+// Compares the values of _A with those of _B, or with the single value
+// of _B if _Scalar, a block at a time.
+static void _CompareBlocks(const decimal_column<decimal64> & _A,
+                           const decimal_column<decimal64> & _B,
+                           bool _Scalar, int8_t * _Out)
+        {
+        const std::size_t _Count = _Scalar ? _A.size() : _CommonSize(_A, _B);
+        const _SimdKernels & _K = _GetSimdKernels();
+
+        // the single value as a block
+        uint64_t _Coeff[64];
+        int16_t _Exp[64];
+        _SimdOperand _S;
+        if (_Scalar)
+                {
+                for (int _I = 0; _I != 64; ++_I)
+                        {
+                        _Coeff[_I] = _B.coefficient(0);
+                        _Exp[_I] = static_cast<int16_t>(_B.exponent(0));
+                        }
+                _S._Coeff = _Coeff;
+                _S._Exp = _Exp;
+                _S._Signs = _B.sign(0) ? ~static_cast<uint64_t>(0) : 0;
+                _S._Specials = _B.is_special(0) ? ~static_cast<uint64_t>(0) :
+                                                  0;
+                }
+
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                const int _N = _BlockSize(_Count, _W);
+                const uint64_t _Done = _K._Compare(
+                        _BlockOf(_A, _W), _Scalar ? _S : _BlockOf(_B, _W), _N,
+                        _Out + 64 * _W);
+                for (int _I = 0; _I != _N; ++_I)
+                        {
+                        if ((_Done >> _I & 1) == 0)
+                                {
+                                const std::size_t _J = 64 * _W + _I;
+                                _Out[_J] = _CompareOne(_A, _J, _B,
+                                                       _Scalar ? 0 : _J);
+                                }
+                        }
+                }
+        }
+
+static void _CompareColumns(const decimal_column<decimal64> & _A,
+                            const decimal_column<decimal64> & _B,
+                            int8_t * _Out)
+        { _CompareBlocks(_A, _B, false, _Out); }
+
+template <class _Dec>
+static void _CompareColumn(const decimal_column<_Dec> & _A, const _Dec & _B,
+                           int8_t * _Out)
+        {
+        const decimal_column<_Dec> _Single(&_B, 1);
+        for (std::size_t _I = 0; _I != _A.size(); ++_I)
+                { _Out[_I] = _CompareOne(_A, _I, _Single, 0); }
+        }
+
+static void _CompareColumn(const decimal_column<decimal64> & _A,
+                           const decimal64 & _B, int8_t * _Out)
+        {
+        const decimal_column<decimal64> _Single(&_B, 1);
+        _CompareBlocks(_A, _Single, true, _Out);
+        }
+
+// Value _I of fmin(_A, _B), or with _Max of fmax(_A, _B).
+template <class _Dec>
+static void _MinMaxOne(const decimal_column<_Dec> & _A,
+                       const decimal_column<_Dec> & _B, bool _Max,
+                       std::size_t _I,
+                       typename _KernelFmt<_Dec>::_Tr::_Context & _Ctxt,
+                       decimal_column<_Dec> & _Out)
+        {
+        const _DecNumber _L(_A.get(_I)), _R(_B.get(_I));
+        _Dec _V;
+        _KernelFmt<_Dec>::_Tr::_FromNumber(&_V, _Max ?
+                _DecNumber::_Max::_Function(_L, _R, _Ctxt) :
+                _DecNumber::_Min::_Function(_L, _R, _Ctxt), &_Ctxt);
+        _Out.set(_I, _V);
+        }
+
+template <class _Dec>
+static uint32_t _MinMaxColumns(const decimal_column<_Dec> & _A,
+                               const decimal_column<_Dec> & _B, bool _Max,
+                               decimal_column<_Dec> & _Out)
+        {
+        typename _KernelFmt<_Dec>::_Tr::_Context _Ctxt(false);
+        const std::size_t _Count = _CommonSize(_A, _B);
+        _Out.resize(_Count);
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _MinMaxOne(_A, _B, _Max, _I, _Ctxt, _Out); }
+        return _Ctxt.status;
+        }
+
+static uint32_t _MinMaxColumns(const decimal_column<decimal64> & _A,
+                               const decimal_column<decimal64> & _B,
+                               bool _Max, decimal_column<decimal64> & _Out)
+        {
+        _Context64 _Ctxt(false);
+        const std::size_t _Count = _CommonSize(_A, _B);
+        _Out.resize(_Count);
+        const _SimdKernels & _K = _GetSimdKernels();
+        uint64_t _Coeff[64];
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                const int _N = _BlockSize(_Count, _W);
+                const _SimdOperand _X = _BlockOf(_A, _W);
+                const _SimdOperand _Y = _BlockOf(_B, _W);
+                uint64_t _FromB;
+                const uint64_t _Done = _K._MinMax(_X, _Y, _N, _Max, _FromB);
+                for (int _I = 0; _I != _N; ++_I)
+                        {
+                        const uint64_t _Pick = 0 - (_FromB >> _I & 1);
+                        _Coeff[_I] = (_X._Coeff[_I] & ~_Pick) |
+                                     (_Y._Coeff[_I] & _Pick);
+                        }
+                for (int _I = 0; _I != _N; ++_I)
+                        {
+                        if ((_Done >> _I & 1) == 0)
+                                {
+                                _MinMaxOne(_A, _B, _Max, 64 * _W + _I, _Ctxt,
+                                           _Out);
+                                }
+                        }
+                _StoreBlock(_Out, _W, _Done, _Coeff, _X._Exp,
+                            (_X._Signs & ~_FromB) | (_Y._Signs & _FromB));
+                }
+        return _Ctxt.status;
+        }
+
+template <class _Dec>
+static std::size_t _FilterColumn(const decimal_column<_Dec> & _In,
+                                 const int8_t * _Mask,
+                                 decimal_column<_Dec> & _Out)
+        {
+        std::size_t _Count = 0;
+        for (std::size_t _I = 0; _I != _In.size(); ++_I)
+                {
+                if (_Mask[_I] != 0)
+                        { ++_Count; }
+                }
+        _Out.resize(0);
+        _Out.resize(_Count);
+        for (std::size_t _I = 0, _J = 0; _J != _Count; ++_I)
+                {
+                if (_Mask[_I] != 0)
+                        { _Out._CopyFrom(_J++, _In, _I); }
+                }
+        return _Count;
+        }
+
+void unpack(const decimal64 * _In, std::size_t _Count, uint64_t * _Coeffs,
+            int16_t * _Exps, uint64_t * _Signs, uint64_t * _Specials)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _UnpackValues(_In, _Count, _Coeffs, _Exps, _Signs, _Specials);
+#else
+        const _SimdKernels & _K = _GetSimdKernels();
+        uint64_t _Words[64];
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                const int _N = _BlockSize(_Count, _W);
+                for (int _I = 0; _I != _N; ++_I)
+                        { _Words[_I] = _GetWord(_In[64 * _W + _I]); }
+                _Specials[_W] = _K._Decode(_Words, _N, _Coeffs + 64 * _W,
+                                           _Exps + 64 * _W, _Signs[_W]);
+                }
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+void unpack(const decimal128 * _In, std::size_t _Count, _Uint128 * _Coeffs,
+            int16_t * _Exps, uint64_t * _Signs, uint64_t * _Specials)
+        { _UnpackValues(_In, _Count, _Coeffs, _Exps, _Signs, _Specials); }
+
+void pack(const uint64_t * _Coeffs, const int16_t * _Exps,
+          const uint64_t * _Signs, const uint64_t * _Specials,
+          std::size_t _Count, decimal64 * _Out)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _PackValues(_Coeffs, _Exps, _Signs, _Specials, _Count, _Out);
+#else
+        const _SimdKernels & _K = _GetSimdKernels();
+        uint64_t _Words[64];
+        for (std::size_t _W = 0; 64 * _W < _Count; ++_W)
+                {
+                const int _N = _BlockSize(_Count, _W);
+                _SimdOperand _X;
+                _X._Coeff = _Coeffs + 64 * _W;
+                _X._Exp = _Exps + 64 * _W;
+                _X._Signs = _Signs[_W];
+                _X._Specials = _Specials[_W];
+                _K._Encode(_X, _N, _Words);
+                for (int _I = 0; _I != _N; ++_I)
+                        { _SetWord(_Out[64 * _W + _I], _Words[_I]); }
+                }
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+void pack(const _Uint128 * _Coeffs, const int16_t * _Exps,
+          const uint64_t * _Signs, const uint64_t * _Specials,
+          std::size_t _Count, decimal128 * _Out)
+        { _PackValues(_Coeffs, _Exps, _Signs, _Specials, _Count, _Out); }
+
+uint32_t add(const decimal_column<decimal64> & _A,
+             const decimal_column<decimal64> & _B,
+             decimal_column<decimal64> & _Out)
+        { return _AddColumns(_A, _B, 0, _Out); }
+
+uint32_t add(const decimal_column<decimal128> & _A,
+             const decimal_column<decimal128> & _B,
+             decimal_column<decimal128> & _Out)
+        { return _AddColumns(_A, _B, 0, _Out); }
+
+uint32_t subtract(const decimal_column<decimal64> & _A,
+                  const decimal_column<decimal64> & _B,
+                  decimal_column<decimal64> & _Out)
+        { return _AddColumns(_A, _B, 1, _Out); }
+
+uint32_t subtract(const decimal_column<decimal128> & _A,
+                  const decimal_column<decimal128> & _B,
+                  decimal_column<decimal128> & _Out)
+        { return _AddColumns(_A, _B, 1, _Out); }
+
+uint32_t fmin(const decimal_column<decimal64> & _A,
+              const decimal_column<decimal64> & _B,
+              decimal_column<decimal64> & _Out)
+        { return _MinMaxColumns(_A, _B, false, _Out); }
+
+uint32_t fmin(const decimal_column<decimal128> & _A,
+              const decimal_column<decimal128> & _B,
+              decimal_column<decimal128> & _Out)
+        { return _MinMaxColumns(_A, _B, false, _Out); }
+
+uint32_t fmax(const decimal_column<decimal64> & _A,
+              const decimal_column<decimal64> & _B,
+              decimal_column<decimal64> & _Out)
+        { return _MinMaxColumns(_A, _B, true, _Out); }
+
+uint32_t fmax(const decimal_column<decimal128> & _A,
+              const decimal_column<decimal128> & _B,
+              decimal_column<decimal128> & _Out)
+        { return _MinMaxColumns(_A, _B, true, _Out); }
+
+void compare(const decimal_column<decimal64> & _A,
+             const decimal_column<decimal64> & _B, int8_t * _Out)
+        { _CompareColumns(_A, _B, _Out); }
+
+void compare(const decimal_column<decimal128> & _A,
+             const decimal_column<decimal128> & _B, int8_t * _Out)
+        { _CompareColumns(_A, _B, _Out); }
+
+void compare(const decimal_column<decimal64> & _A, decimal64 _B,
+             int8_t * _Out)
+        { _CompareColumn(_A, _B, _Out); }
+
+void compare(const decimal_column<decimal128> & _A, decimal128 _B,
+             int8_t * _Out)
+        { _CompareColumn(_A, _B, _Out); }
+
+std::size_t filter(const decimal_column<decimal64> & _In,
+                   const int8_t * _Mask, decimal_column<decimal64> & _Out)
+        { return _FilterColumn(_In, _Mask, _Out); }
+
+std::size_t filter(const decimal_column<decimal128> & _In,
+                   const int8_t * _Mask, decimal_column<decimal128> & _Out)
+        { return _FilterColumn(_In, _Mask, _Out); }
+
+} // namespace decimal
+} // namespace std
@@ -15,7 +15,9 @@
 
 #include <climits>
 #include <cmath>
+#include <cstring>
 #include <limits>
+#include <string>
 
 #define DECNUMDIGITS 45 // IMPORTANT: must appear first!
 extern "C" {
@@ -26,6 +28,7 @@ extern "C" {
 #include "decimal32.h"
 }
 #include "decimal"
+#include "impl/decNative.h"
 
 namespace std {
 namespace decimal {
@@ -449,6 +452,11 @@ _DecNumber::_DecNumber(_DecBase<_FmtTraits<decimal64> > source)
         {
         for (size_t i = 0; i != lsu_extent; ++i)
                 { lsu[i] = 0; }
+#if defined(_DEC_DECIMAL64_BID)
+        _Native64 _N;
+        _Unpack(source, _N);
+        _SetWord(source, _PackDPD<_Layout64>(_N));
+#endif /* defined(_DEC_DECIMAL64_BID) */
         decimal64ToNumber(reinterpret_cast< ::decimal64 *>(&source), this);
         }
 
@@ -562,6 +570,11 @@ void _DecNumber::_ToDecimal64(_DecBase<_FmtTraits<decimal64> > * _Tgt,
         {
         decimal64FromNumber(reinterpret_cast< ::decimal64 *>(_Tgt),
                             this, _Ctxt);
+#if defined(_DEC_DECIMAL64_BID)
+        _Native64 _N;
+        _UnpackDPD<_Layout64>(_GetWord(*_Tgt), _N);
+        _Pack(*_Tgt, _N);
+#endif /* defined(_DEC_DECIMAL64_BID) */
         }
 
 void _DecNumber::_ToDecimal128(_DecBase<_FmtTraits<decimal128> > * _Tgt,
@@ -571,5 +584,114 @@ void _DecNumber::_ToDecimal128(_DecBase<_FmtTraits<decimal128> > * _Tgt,
                              this, _Ctxt);
         }
 
+static inline bool _IsDigitChar(char _C)
+        { return _C >= '0' && _C <= '9'; }
+
+// the end of _Word (in lower case) at _Ptr, in either case, or null
+static const char * _MatchWord(const char * _Ptr, const char * _Last,
+                               const char * _Word)
+        {
+        for (; *_Word != '\0'; ++_Ptr, ++_Word)
+                {
+                if (_Ptr == _Last || (*_Ptr | 0x20) != *_Word)
+                        { return 0; }
+                }
+        return _Ptr;
+        }
+
+const char * _DecNumber::_FromChars(const char * _First,
+                                    const char * _Last,
+                                    ::decContext * _Ctxt)
+        {
+        const char * _Ptr = _First;
+
+        if (_Ptr != _Last && (*_Ptr == '+' || *_Ptr == '-'))
+                { ++_Ptr; }
+        const char * _Body = _Ptr;
+
+        if (_Ptr != _Last && !_IsDigitChar(*_Ptr) && *_Ptr != '.')
+                {
+                // infinities, and NaNs with as many digits of payload
+                // as decNumberFromString takes (one fewer than the
+                // precision for a clamped format), past leading zeros;
+                // the longest spelling that matches is taken
+                const char * _End;
+                if ((_End = _MatchWord(_Ptr, _Last, "infinity")) != 0 ||
+                    (_End = _MatchWord(_Ptr, _Last, "inf")) != 0)
+                        { _Ptr = _End; }
+                else if ((_End = _MatchWord(_Ptr, _Last, "nan")) != 0 ||
+                         (_End = _MatchWord(_Ptr, _Last, "snan")) != 0)
+                        {
+                        const int32_t _Max =
+                                _Ctxt->digits - (_Ctxt->clamp ? 1 : 0);
+                        int32_t _D = 0;
+                        for (_Ptr = _End; _Ptr != _Last && _IsDigitChar(*_Ptr);
+                             ++_Ptr)
+                                {
+                                if ((_D != 0 || *_Ptr != '0') && ++_D > _Max)
+                                        { break; }
+                                }
+                        }
+                }
+        else
+                {
+                bool _HasDigits = false;
+                for (; _Ptr != _Last && _IsDigitChar(*_Ptr); ++_Ptr)
+                        { _HasDigits = true; }
+                if (_Ptr != _Last && *_Ptr == '.')
+                        {
+                        for (++_Ptr; _Ptr != _Last && _IsDigitChar(*_Ptr);
+                             ++_Ptr)
+                                { _HasDigits = true; }
+                        }
+                if (!_HasDigits)
+                        { return _First; }
+
+                // The exponent is only part of the number if at least
+                // one digit follows the 'E' (and its optional sign).
+                if (_Ptr != _Last && (*_Ptr == 'e' || *_Ptr == 'E'))
+                        {
+                        const char * _Exp = _Ptr + 1;
+                        if (_Exp != _Last && (*_Exp == '+' || *_Exp == '-'))
+                                { ++_Exp; }
+                        if (_Exp != _Last && _IsDigitChar(*_Exp))
+                                {
+                                for (_Ptr = _Exp;
+                                     _Ptr != _Last && _IsDigitChar(*_Ptr);
+                                     ++_Ptr)
+                                        { }
+                                }
+                        }
+                }
+
+        if (_Ptr == _Body)
+                { return _First; }
+
+        // decNumberFromString wants a terminated string; short numbers
+        // (the usual case) are copied to the stack.
+        const size_t _Len = _Ptr - _First;
+        char _Buf[64];
+        std::string _LongStr;
+        const char * _Str = _Buf;
+        if (_Len < sizeof(_Buf))
+                {
+                memcpy(_Buf, _First, _Len);
+                _Buf[_Len] = '\0';
+                }
+        else
+                {
+                _LongStr.assign(_First, _Ptr);
+                _Str = _LongStr.c_str();
+                }
+
+        const uint32_t _Saved = _Ctxt->status;
+        _Ctxt->status = 0;
+        decNumberFromString(this, _Str, _Ctxt);
+        const bool _Failed = (_Ctxt->status & DEC_Conversion_syntax) != 0;
+        _Ctxt->status |= _Saved;
+
+        return _Failed ? _First : _Ptr;
+        }
+
 } // namespace decimal
 } // namespace std
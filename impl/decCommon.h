@@ -250,8 +250,8 @@ struct _DecNumber : public decNumber {
 
         _DecNumber(unsigned long long _Coeff, int32_t _Exp, bool _Sign)
                 {
-                bits = _Sign ? DECNEG : 0;
                 _FromUnsignedIntegral(_Coeff);
+                bits = _Sign ? DECNEG : 0;
                 exponent += _Exp;
                 }
 
@@ -310,7 +310,7 @@ struct _DecNumber : public decNumber {
                 {
                 _DecNumber _Tmp(*this);
                 decNumberTrim(&_Tmp); 
-                return _Tmp.exponent + 1 > _Tmp.digits;
+                return _Tmp.exponent >= 0;
                 }
 
         // sign:
@@ -409,6 +409,9 @@ struct _DecNumber : public decNumber {
         template <class _Op, class _Tr>
         static typename _Tr::_Fmt _UnaryMathFn(const _DecNumber &_Rhs);
 
+        template <class _Op, class _Tr>
+        static typename _Tr::_Fmt _WideMathFn(const _DecNumber &_Rhs);
+
         // unary math functions
         struct _Ceil {
                 static _DecNumber _Function(const _DecNumber &_Rhs,
@@ -472,10 +475,7 @@ struct _DecNumber : public decNumber {
                         if (_Rhs._IsZero())
                                 { _Context._RangeError(); }
                         else
-                                {
-                                decNumberNormalize(&_Result, &_Rhs, &_Context);
-                                _Result = _DecNumber(_Result.exponent);
-                                }
+                                { decNumberLogB(&_Result, &_Rhs, &_Context); }
                         return _Result;
                         }
                 };
@@ -583,8 +583,8 @@ struct _DecNumber : public decNumber {
                                             _ContextBase &_Context)
                         {
                         _DecNumber _Result;
-                        if (_Rhs._IsNeg() && _Rhs._IsFinite() &&
-                            !_Lhs._IsInteger())
+                        if (_Lhs._IsNeg() && _Lhs._IsFinite() &&
+                            !_Rhs._IsInteger())
                                 { _Context._DomainError(); }
                         else if (_Lhs._IsZero())
                                 {
@@ -629,6 +629,35 @@ struct _DecNumber : public decNumber {
                         return _Result;
                         }
                 };
+        struct _Scaleb {
+                static _DecNumber _Function(const _DecNumber &_Lhs,
+                                            const _DecNumber &_Rhs,
+                                            _ContextBase &_Context)
+                        {
+                        _DecNumber _Result;
+                        decNumberScaleB(&_Result, &_Lhs, &_Rhs, &_Context);
+                        return _Result;
+                        }
+                };
+
+        // utilities for three-argument math functions
+        template <class _Op, class _Tr>
+        static typename _Tr::_Fmt _TernaryMathFn(const _DecNumber &_X,
+                                                 const _DecNumber &_Y,
+                                                 const _DecNumber &_Z);
+
+        // three-argument math functions
+        struct _Fma {
+                static _DecNumber _Function(const _DecNumber &_X,
+                                            const _DecNumber &_Y,
+                                            const _DecNumber &_Z,
+                                            _ContextBase &_Context)
+                        {
+                        _DecNumber _Result;
+                        decNumberFMA(&_Result, &_X, &_Y, &_Z, &_Context);
+                        return _Result;
+                        }
+                };
 
         // utilities for relational operations
         template <class _CompareOp>
@@ -698,6 +727,10 @@ struct _DecNumber : public decNumber {
                 }
 #endif /* def _DEC_HAS_C99_MATH */
 
+        // scalbn function
+        template <class _Tr>
+        static typename _Tr::_Fmt _Scalbn(const _DecNumber &_Lhs, long _Pow);
+
         // formatted output
         template <class _CharType, class _Iter>
         _Iter _DoPut(_Iter _S,
@@ -717,6 +750,11 @@ struct _DecNumber : public decNumber {
                      std::ios_base & _F,
                      std::ios_base::iostate & _Err);
 
+        // unformatted input (see <deccharconv>)
+        const char * _FromChars(const char * _First,
+                                const char * _Last,
+                                ::decContext * _Context);
+
 private:
 
         // constants for formatted input/output of NAN and INF
@@ -874,6 +912,27 @@ typename _Tr::_Fmt _DecNumber::_UnaryMathFn(const _DecNumber & _Rhs)
         return _Result;
         }
 
+// Likewise, but evaluated to DECNUMDIGITS digits and then rounded once
+// to the format in the current rounding mode.  decNumberExp(),
+// decNumberLn() and decNumberLog10() do not follow the directed modes
+// reliably at the precision of the format; this does for any format
+// well short of DECNUMDIGITS digits.
+template <class _Op, class _Tr> inline
+typename _Tr::_Fmt _DecNumber::_WideMathFn(const _DecNumber & _Rhs)
+        {
+        typename _Tr::_Context _Ctxt(false);
+        typename _Tr::_Context _Wide(false);
+        _Wide.digits = DECNUMDIGITS;
+        _Wide.clamp = 0;
+        typename _Tr::_Fmt _Result;
+        const _DecNumber _Tmp = _Op::_Function(_Rhs, _Wide);
+        _DecNumber _Rounded;
+        decNumberPlus(&_Rounded, &_Tmp, &_Ctxt);
+        _Ctxt.status |= _Wide.status;
+        _Tr::_FromNumber(&_Result, _Rounded, &_Ctxt);
+        return _Result;
+        }
+
 // utilites for two-argument operations
 template <class _Op, class _Tr> inline
 typename _Tr::_Fmt
@@ -886,6 +945,34 @@ _DecNumber::_BinaryMathFn(const _DecNumber &_Lhs, const _DecNumber &_Rhs)
         return _Result;
         }
 
+// scalbn function; decNumberScaleB rejects a power beyond twice the
+// range of the exponents, which no nonzero value survives anyway
+template <class _Tr> inline
+typename _Tr::_Fmt _DecNumber::_Scalbn(const _DecNumber &_Lhs, long _Pow)
+        {
+        typename _Tr::_Context _Ctxt(false);
+        typename _Tr::_Fmt _Result;
+        const long _Limit = 2L * (_Ctxt.emax + _Ctxt.digits);
+        const _DecNumber _Rhs(_Pow < -_Limit ? -_Limit :
+                              _Pow > _Limit ? _Limit : _Pow);
+        _DecNumber _Tmp = _Scaleb::_Function(_Lhs, _Rhs, _Ctxt);
+        _Tr::_FromNumber(&_Result, _Tmp, &_Ctxt);
+        return _Result;
+        }
+
+// utilities for three-argument operations
+template <class _Op, class _Tr> inline
+typename _Tr::_Fmt
+_DecNumber::_TernaryMathFn(const _DecNumber &_X, const _DecNumber &_Y,
+                           const _DecNumber &_Z)
+        {
+        typename _Tr::_Context _Ctxt(false);
+        typename _Tr::_Fmt _Result;
+        _DecNumber _Tmp = _Op::_Function(_X, _Y, _Z, _Ctxt);
+        _Tr::_FromNumber(&_Result, _Tmp, &_Ctxt);
+        return _Result;
+        }
+
 // utilities for relational operations
 template <class _CompareOp> inline
 bool _DecNumber::_Compare(const _DecNumber &_Lhs,
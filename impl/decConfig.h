@@ -40,6 +40,36 @@
                              128-bit IEEE binary floating-point format to
                              represent a long double.
 
+   Encoding settings:
+   ------------------
+   _DEC_DECIMAL64_BID     -- #define this macro to make decimal64 hold its
+                             value in the IEEE 754 binary integer decimal
+                             (BID) encoding, which is the encoding used by
+                             the _Decimal64 type of GCC and the Intel
+                             compilers, instead of the densely packed
+                             decimal (DPD) encoding.  The coefficient of a
+                             BID value is a plain binary integer.  This
+                             setting changes the bytes seen by <decbytes>;
+                             use the converters in <decbid> to exchange
+                             values with DPD systems.  All translation
+                             units of a program must agree on it.
+
+   Evaluation settings:
+   --------------------
+   _DEC_EXPRESSION_TEMPLATES
+                          -- #define this macro, before including <decimal>,
+                             to make the operators +, -, * and / of decimal
+                             operands build expression objects that are
+                             evaluated only when converted to a decimal
+                             type, compared or passed to evaluate(), with
+                             each operand decoded once and no intermediate
+                             result encoded.  The results are those of the
+                             operators unless evaluate() is asked to round
+                             once (see impl/decExpr.h).  An expression is
+                             not itself a decimal type, so "auto" and
+                             template argument deduction see the expression
+                             object.
+
    C++ compiler language support settings:
    ---------------------------------------
    _DEC_HAS_C99_MATH      -- #define this macro if your environment supports
@@ -67,6 +97,43 @@
                              (eg. #define _DEC_STATIC_ASSERT __static_assert).
                              If your compiler supports neither form, leave
                              this macro undefined.
+   _DEC_HAS_STD_FORMAT    -- #define this macro if your C++ environment
+                             provides the C++20 header <format>.  The header
+                             <decformat> then specializes std::formatter for
+                             the decimal types.  It is #defined below when
+                             the compiler can find <format>.
+   _DEC_HAS_FMT           -- #define this macro to have <decformat> also
+                             specialize fmt::formatter of the {fmt} library,
+                             whose header <fmt/format.h> must then be on the
+                             include path.
+
+   _DEC_HAS_INT128        -- #define this macro if your compiler provides the
+                             128-bit integer types __int128 and unsigned
+                             __int128.  The fast paths of exp(), log() and
+                             log10() for decimal32 and decimal64 are built
+                             on them; without them these functions always
+                             go through decNumber.  It is #defined below
+                             when the compiler predefines __SIZEOF_INT128__.
+   _DEC_HAS_X86_SIMD      -- #define this macro if your compiler accepts the
+                             x86 intrinsics of <immintrin.h> in functions
+                             marked __attribute__((target(...))), and
+                             provides __builtin_cpu_supports.  The
+                             operations on decimal64 columns in <deccolumn>
+                             then use AVX2 or AVX-512 when the processor
+                             has them.  It is #defined below for GCC and
+                             Clang on x86.
+
+   Operating system support settings:
+   ----------------------------------
+   _DEC_HAS_MMAP          -- #define this macro if your environment supports
+                             the POSIX mmap() interface.  The bulk file
+                             loader in <decloader> will map its input file
+                             instead of reading it into a buffer.
+   _DEC_HAS_PTHREADS      -- #define this macro if your environment supports
+                             POSIX threads.  The bulk facilities of this
+                             library (eg. <decloader>) will then spread
+                             their work across threads; otherwise they run
+                             on the calling thread only.
 */
 
 /*************************************************************************
@@ -125,6 +192,33 @@
 #  define _DEC_LONGDOUBLE80 1
 #endif /* defined(__MINGW__) */
 
+// Configuration for POSIX systems:
+
+#if defined(__unix__) || defined(__APPLE__)
+#  define _DEC_HAS_MMAP 1
+#  define _DEC_HAS_PTHREADS 1
+#endif /* defined(__unix__) || defined(__APPLE__) */
+
+// Configuration for compilers with 128-bit integers:
+
+#if defined(__SIZEOF_INT128__)
+#  define _DEC_HAS_INT128 1
+#endif /* defined(__SIZEOF_INT128__) */
+
+// Configuration for GCC and Clang on x86:
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define _DEC_HAS_X86_SIMD 1
+#endif /* defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) */
+
+// Configuration for C++20 environments:
+
+#if defined(__has_include) && __cplusplus >= 202002L
+#  if __has_include(<format>)
+#    define _DEC_HAS_STD_FORMAT 1
+#  endif /* __has_include(<format>) */
+#endif /* defined(__has_include) && __cplusplus >= 202002L */
+
 /*************************************************************************
   Configuration code:
   Do not modify the code below this line.
@@ -51,6 +51,47 @@ const uint8_t _FmtTraits<decimal32>::_SNAN[] = {
 0x7E, 0x0,  0x0,  0x0
 };
 
+#if defined(_DEC_DECIMAL64_BID)
+const uint8_t _FmtTraits<decimal64>::_Zero[] = {
+0x31, 0xC0, 0x0,  0x0,
+0x0,  0x0,  0x0,  0x0
+};
+
+const uint8_t _FmtTraits<decimal64>::_Max[] = {
+0x77, 0xFB, 0x86, 0xF2,
+0x6F, 0xC0, 0xFF, 0xFF
+};
+
+const uint8_t _FmtTraits<decimal64>::_Min[] = {
+0x1,  0xE0, 0x0,  0x0,
+0x0,  0x0,  0x0,  0x1
+};
+
+const uint8_t _FmtTraits<decimal64>::_Epsilon[] = {
+0x2F, 0xE0, 0x0,  0x0,
+0x0,  0x0,  0x0,  0x1
+};
+
+const uint8_t _FmtTraits<decimal64>::_Denormalized_min[] = {
+0x0,  0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x1
+};
+
+const uint8_t _FmtTraits<decimal64>::_INF[] = {
+0x78, 0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x0
+};
+
+const uint8_t _FmtTraits<decimal64>::_NAN[] = {
+0x7C, 0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x0
+};
+
+const uint8_t _FmtTraits<decimal64>::_SNAN[] = {
+0x7E, 0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x0
+};
+#else
 const uint8_t _FmtTraits<decimal64>::_Zero[] = {
 0x22, 0x38, 0x0,  0x0,
 0x0,  0x0,  0x0,  0x0
@@ -90,6 +131,7 @@ const uint8_t _FmtTraits<decimal64>::_SNAN[] = {
 0x7E, 0x0,  0x0,  0x0,
 0x0,  0x0,  0x0,  0x0
 };
+#endif /* defined(_DEC_DECIMAL64_BID) */
 
 const uint8_t _FmtTraits<decimal128>::_Zero[] = {
 0x22, 0x8,  0x0,  0x0,
@@ -181,6 +223,47 @@ const uint8_t _FmtTraits<decimal32>::_SNAN[] = {
 0x0,  0x0,  0x0,  0x7E
 };
 
+#if defined(_DEC_DECIMAL64_BID)
+const uint8_t _FmtTraits<decimal64>::_Zero[] = {
+0x0,  0x0,  0x0,  0x0,
+0x0,  0x0,  0xC0, 0x31
+};
+
+const uint8_t _FmtTraits<decimal64>::_Max[] = {
+0xFF, 0xFF, 0xC0, 0x6F,
+0xF2, 0x86, 0xFB, 0x77
+};
+
+const uint8_t _FmtTraits<decimal64>::_Min[] = {
+0x1,  0x0,  0x0,  0x0,
+0x0,  0x0,  0xE0, 0x1
+};
+
+const uint8_t _FmtTraits<decimal64>::_Epsilon[] = {
+0x1,  0x0,  0x0,  0x0,
+0x0,  0x0,  0xE0, 0x2F
+};
+
+const uint8_t _FmtTraits<decimal64>::_Denormalized_min[] = {
+0x1,  0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x0
+};
+
+const uint8_t _FmtTraits<decimal64>::_INF[] = {
+0x0,  0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x78
+};
+
+const uint8_t _FmtTraits<decimal64>::_NAN[] = {
+0x0,  0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x7C
+};
+
+const uint8_t _FmtTraits<decimal64>::_SNAN[] = {
+0x0,  0x0,  0x0,  0x0,
+0x0,  0x0,  0x0,  0x7E
+};
+#else
 const uint8_t _FmtTraits<decimal64>::_Zero[] = {
 0x0,  0x0,  0x0,  0x0,
 0x0,  0x0,  0x38, 0x22
@@ -220,6 +303,7 @@ const uint8_t _FmtTraits<decimal64>::_SNAN[] = {
 0x0,  0x0,  0x0,  0x0,
 0x0,  0x0,  0x0,  0x7E
 };
+#endif /* defined(_DEC_DECIMAL64_BID) */
 
 const uint8_t _FmtTraits<decimal128>::_Zero[] = {
 0x0,  0x0,  0x0,  0x0,
@@ -0,0 +1,518 @@
+/* ------------------------------------------------------------------ */
+/* decExpr.h header                                                   */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+// Expression templates for the arithmetic operators of <decimal>,
+// included by it when _DEC_EXPRESSION_TEMPLATES is #defined (see
+// decConfig.h).  The operators +, -, * and / of decimal and integral
+// operands, and the unary - and + of expressions, then return a
+// _DecExpr node that holds copies of its operands, and the expression
+// is evaluated when it is converted to its format, assigned, compared
+// or passed to evaluate().  Each operand is decoded once into a
+// _DecNumber and the operations are carried out on decNumbers under
+// one working context, so no intermediate result is encoded.
+//
+// By default each operation is rounded to the format the operators of
+// <decimal> give it, so the results and flags are those of evaluating
+// the expression one operator at a time.  evaluate(_X, round_once)
+// instead computes the intermediate results exactly, in working
+// numbers of _ExprNumber::_Digits (136) digits with an unbounded
+// exponent, and rounds only the final result to the format.  That
+// holds the product of two decimal128 values (68 digits), a product
+// of two such products, and the sum of two values whose digits span
+// up to 136 places.  When an intermediate result cannot be held
+// exactly, as with most divisions or a sum of values too far apart,
+// the expression is evaluated again one operation at a time.
+
+#ifndef _DECEXPR_H
+#define _DECEXPR_H
+
+namespace std {
+namespace decimal {
+
+template <class _Op, class _L, class _R>
+class _DecExpr;
+
+template <class _Op, class _A>
+class _DecUnaryExpr;
+
+// expression nodes
+template <class _T>
+struct _Is_dec_expr {
+        static const bool value = false;
+};
+
+template <class _Op, class _L, class _R>
+struct _Is_dec_expr<_DecExpr<_Op, _L, _R> > {
+        static const bool value = true;
+};
+
+template <class _Op, class _A>
+struct _Is_dec_expr<_DecUnaryExpr<_Op, _A> > {
+        static const bool value = true;
+};
+
+// the format of an operand: that of the value of a node, or the type
+// itself for a decimal or an integer (see _PromotionTraits)
+template <class _T, bool = _Is_dec_expr<_T>::value>
+struct _ExprFmt {
+        typedef _T type;
+};
+
+template <class _T>
+struct _ExprFmt<_T, true> {
+        typedef typename _T::_Fmt type;
+};
+
+// the precision and exponent range of each format
+template <class _Fmt>
+struct _ExprLimits;
+
+template <>
+struct _ExprLimits<decimal32> {
+        static const int32_t _Digits = 7;
+        static const int32_t _Emax   = 96;
+        static const int32_t _Emin   = -95;
+};
+
+template <>
+struct _ExprLimits<decimal64> {
+        static const int32_t _Digits = 16;
+        static const int32_t _Emax   = 384;
+        static const int32_t _Emin   = -383;
+};
+
+template <>
+struct _ExprLimits<decimal128> {
+        static const int32_t _Digits = 34;
+        static const int32_t _Emax   = 6144;
+        static const int32_t _Emin   = -6143;
+};
+
+// how evaluate() rounds the operations of an expression
+enum expression_rounding {
+        round_each_operation,   // to its format, as the operators do
+        round_once              // only the final result
+};
+
+// An exact intermediate result of round_once evaluation.  Its units run
+// on past the decNumber at the start of _Buf, as decNumber allows.
+struct _ExprNumber {
+        static const int32_t _Digits = 4 * _ExprLimits<decimal128>::_Digits;
+
+        decNumber * _Num()
+                { return _Buf; }
+        const decNumber * _Num() const
+                { return _Buf; }
+
+        decNumber _Buf[((_Digits + DECDPUN - 1) / DECDPUN - 1) *
+                       sizeof(decNumberUnit) / sizeof(decNumber) + 2];
+};
+
+// The working context of an evaluation.  For round_once it holds
+// _ExprNumber::_Digits digits with an unbounded exponent; otherwise
+// each node sets the precision and exponent range of its format before
+// its operation.  The status flags of all the operations accumulate in
+// it.
+struct _ExprContext : _ContextBase {
+        explicit _ExprContext(expression_rounding _Mode) :
+                _ContextBase(false)
+                {
+                decContextDefault(this, DEC_INIT_DECIMAL128);
+                _GetRoundingMode();
+                if (_Mode == round_once)
+                        {
+                        digits = _ExprNumber::_Digits;
+                        emax = DEC_MAX_EMAX;
+                        emin = DEC_MIN_EMIN;
+                        clamp = 0;
+                        }
+                }
+
+        template <class _Fmt>
+        void _Enter()
+                {
+                digits = _ExprLimits<_Fmt>::_Digits;
+                emax = _ExprLimits<_Fmt>::_Emax;
+                emin = _ExprLimits<_Fmt>::_Emin;
+                }
+};
+
+// the decNumber operation of each operator, for exact evaluation
+template <class _Op>
+struct _ExprExactOp;
+
+template <>
+struct _ExprExactOp<_DecNumber::_Add> {
+        static void _Operator(decNumber * _Res, const decNumber * _Lhs,
+                              const decNumber * _Rhs, ::decContext * _Ctxt)
+                { decNumberAdd(_Res, _Lhs, _Rhs, _Ctxt); }
+};
+
+template <>
+struct _ExprExactOp<_DecNumber::_Sub> {
+        static void _Operator(decNumber * _Res, const decNumber * _Lhs,
+                              const decNumber * _Rhs, ::decContext * _Ctxt)
+                { decNumberSubtract(_Res, _Lhs, _Rhs, _Ctxt); }
+};
+
+template <>
+struct _ExprExactOp<_DecNumber::_Mul> {
+        static void _Operator(decNumber * _Res, const decNumber * _Lhs,
+                              const decNumber * _Rhs, ::decContext * _Ctxt)
+                { decNumberMultiply(_Res, _Lhs, _Rhs, _Ctxt); }
+};
+
+template <>
+struct _ExprExactOp<_DecNumber::_Div> {
+        static void _Operator(decNumber * _Res, const decNumber * _Lhs,
+                              const decNumber * _Rhs, ::decContext * _Ctxt)
+                { decNumberDivide(_Res, _Lhs, _Rhs, _Ctxt); }
+};
+
+template <>
+struct _ExprExactOp<_DecNumber::_Plus> {
+        static void _Operator(decNumber * _Res, const decNumber * _Rhs,
+                              ::decContext * _Ctxt)
+                { decNumberPlus(_Res, _Rhs, _Ctxt); }
+};
+
+template <>
+struct _ExprExactOp<_DecNumber::_Minus> {
+        static void _Operator(decNumber * _Res, const decNumber * _Rhs,
+                              ::decContext * _Ctxt)
+                { decNumberMinus(_Res, _Rhs, _Ctxt); }
+};
+
+// the value of an operand
+template <class _Tr> inline
+_DecNumber _ExprValue(const _DecBase<_Tr> & _V, _ExprContext &)
+        { return _DecNumber(_V); }
+
+template <class _T> inline
+typename _Enable_if_c<std::tr1::is_integral<_T>::value, _DecNumber>::type
+_ExprValue(_T _V, _ExprContext &)
+        { return _DecNumber(_V); }
+
+template <class _Op, class _L, class _R> inline
+_DecNumber _ExprValue(const _DecExpr<_Op, _L, _R> & _X,
+                      _ExprContext & _Ctxt)
+        { return _X._Value(_Ctxt); }
+
+template <class _Op, class _A> inline
+_DecNumber _ExprValue(const _DecUnaryExpr<_Op, _A> & _X,
+                      _ExprContext & _Ctxt)
+        { return _X._Value(_Ctxt); }
+
+// the exact value of an operand
+template <class _Tr> inline
+void _ExprExact(const _DecBase<_Tr> & _V, _ExprContext &,
+                _ExprNumber & _Result)
+        {
+        const _DecNumber _N(_V);
+        decNumberCopy(_Result._Num(), &_N);
+        }
+
+template <class _T> inline
+typename _Enable_if_c<std::tr1::is_integral<_T>::value, void>::type
+_ExprExact(_T _V, _ExprContext &, _ExprNumber & _Result)
+        {
+        const _DecNumber _N(_V);
+        decNumberCopy(_Result._Num(), &_N);
+        }
+
+template <class _Op, class _L, class _R> inline
+void _ExprExact(const _DecExpr<_Op, _L, _R> & _X, _ExprContext & _Ctxt,
+                _ExprNumber & _Result)
+        { _X._Exact(_Ctxt, _Result); }
+
+template <class _Op, class _A> inline
+void _ExprExact(const _DecUnaryExpr<_Op, _A> & _X, _ExprContext & _Ctxt,
+                _ExprNumber & _Result)
+        { _X._Exact(_Ctxt, _Result); }
+
+// Evaluates _X into its format, rounding as _Mode says.  round_once
+// falls back to rounding each operation when an intermediate result
+// was not exact, and then gives only the flags of that evaluation.
+template <class _E> inline
+typename _Enable_if_c<_Is_dec_expr<_E>::value, typename _E::_Fmt>::type
+evaluate(const _E & _X, expression_rounding _Mode = round_each_operation)
+        {
+        typedef _FmtTraits<typename _E::_Fmt> _Tr;
+        typename _Tr::_Context _Ctxt;
+        typename _Tr::_Fmt _Result;
+        if (_Mode == round_once)
+                {
+                _ExprContext _Work(round_once);
+                _ExprNumber _V;
+                _X._Exact(_Work, _V);
+                if ((_Work.status & (DEC_Inexact | DEC_Rounded)) == 0)
+                        {
+                        _DecNumber _N;
+                        decNumberPlus(&_N, _V._Num(), &_Ctxt);
+                        _Ctxt.status |= _Work.status;
+                        _Tr::_FromNumber(&_Result, _N, &_Ctxt);
+                        return _Result;
+                        }
+                }
+        _ExprContext _Work(round_each_operation);
+        const _DecNumber _N(_X._Value(_Work));
+        _Ctxt.status |= _Work.status;
+        _Tr::_FromNumber(&_Result, _N, &_Ctxt);
+        return _Result;
+        }
+
+// a binary operation _Op of _L and _R
+template <class _Op, class _L, class _R>
+class _DecExpr {
+public:
+        typedef typename _PromotionTraits<typename _ExprFmt<_L>::type,
+                                          typename _ExprFmt<_R>::type>::type
+                _Fmt;
+
+        _DecExpr(const _L & _Lhs, const _R & _Rhs) :
+                _Left(_Lhs), _Right(_Rhs)
+                { }
+
+        operator _Fmt() const
+                { return evaluate(*this); }
+
+        _DecNumber _Value(_ExprContext & _Ctxt) const
+                {
+                const _DecNumber _A(_ExprValue(_Left, _Ctxt));
+                const _DecNumber _B(_ExprValue(_Right, _Ctxt));
+                _Ctxt._Enter<_Fmt>();
+                return _Op::_Operator(_A, _B, &_Ctxt);
+                }
+
+        void _Exact(_ExprContext & _Ctxt, _ExprNumber & _Result) const
+                {
+                _ExprNumber _A;
+                _ExprNumber _B;
+                _ExprExact(_Left, _Ctxt, _A);
+                _ExprExact(_Right, _Ctxt, _B);
+                _ExprExactOp<_Op>::_Operator(_Result._Num(), _A._Num(),
+                                             _B._Num(), &_Ctxt);
+                }
+
+private:
+        _L _Left;
+        _R _Right;
+};
+
+// a unary operation _Op of _A
+template <class _Op, class _A>
+class _DecUnaryExpr {
+public:
+        typedef typename _ExprFmt<_A>::type _Fmt;
+
+        explicit _DecUnaryExpr(const _A & _Arg) :
+                _Operand(_Arg)
+                { }
+
+        operator _Fmt() const
+                { return evaluate(*this); }
+
+        _DecNumber _Value(_ExprContext & _Ctxt) const
+                {
+                const _DecNumber _V(_ExprValue(_Operand, _Ctxt));
+                _Ctxt._Enter<_Fmt>();
+                return _Op::_Operator(_V, &_Ctxt);
+                }
+
+        void _Exact(_ExprContext & _Ctxt, _ExprNumber & _Result) const
+                {
+                _ExprNumber _V;
+                _ExprExact(_Operand, _Ctxt, _V);
+                _ExprExactOp<_Op>::_Operator(_Result._Num(), _V._Num(),
+                                             &_Ctxt);
+                }
+
+private:
+        _A _Operand;
+};
+
+// template constraints: the operands of the binary operators are
+// decimals, integers and nodes, not both of them integers; at least one
+// operand of a relational operator or the right operand of a compound
+// assignment is a node
+template <class _T>
+struct _Is_expr_operand {
+        static const bool value = _Is_int_or_dec<_T>::value ||
+                                  _Is_dec_expr<_T>::value;
+};
+
+template <class _Op, class _LHS, class _RHS>
+struct _Expr_if_operands :
+         public _Enable_if_c<_Is_expr_operand<_LHS>::value &&
+                             _Is_expr_operand<_RHS>::value &&
+                             !(std::tr1::is_integral<_LHS>::value &&
+                               std::tr1::is_integral<_RHS>::value),
+                             _DecExpr<_Op, _LHS, _RHS> > {};
+
+template <class _LHS, class _RHS>
+struct _Compare_if_expr :
+         public _Enable_if_c<_Is_expr_operand<_LHS>::value &&
+                             _Is_expr_operand<_RHS>::value &&
+                             (_Is_dec_expr<_LHS>::value ||
+                              _Is_dec_expr<_RHS>::value),
+                             bool> {};
+
+template <class _LHS, class _RHS>
+struct _Assign_if_expr :
+         public _Enable_if_c<_Is_decimal_fp_aux<_LHS>::value &&
+                             _Is_dec_expr<_RHS>::value,
+                             _LHS &> {};
+
+// the operand of a relational operator: a node evaluated into its
+// format, or the operand itself
+template <class _T> inline
+typename _Enable_if_c<_Is_dec_expr<_T>::value, typename _T::_Fmt>::type
+_ExprOperand(const _T & _X)
+        { return evaluate(_X); }
+
+template <class _T> inline
+typename _Enable_if_c<!_Is_dec_expr<_T>::value, const _T &>::type
+_ExprOperand(const _T & _X)
+        { return _X; }
+
+// _X = _X _Op _Y, with _Y evaluated into its format first, as the
+// compound assignments of <decimal> do
+template <class _Op, class _D, class _E> inline
+void _ExprInPlace(_D & _X, const _E & _Y)
+        {
+        _DecNumber::_BinaryOpInPlace<_Op, _FmtTraits<_D> >(_X, evaluate(_Y),
+                                                           &_X);
+        }
+
+// unary operators
+template <class _E> inline
+typename _Enable_if_c<_Is_dec_expr<_E>::value,
+                      _DecUnaryExpr<_DecNumber::_Plus, _E> >::type
+operator+(const _E & _X)
+        { return _DecUnaryExpr<_DecNumber::_Plus, _E>(_X); }
+
+template <class _E> inline
+typename _Enable_if_c<_Is_dec_expr<_E>::value,
+                      _DecUnaryExpr<_DecNumber::_Minus, _E> >::type
+operator-(const _E & _X)
+        { return _DecUnaryExpr<_DecNumber::_Minus, _E>(_X); }
+
+// binary arithmetic operators
+template <class _LHS, class _RHS> inline
+typename _Expr_if_operands<_DecNumber::_Add, _LHS, _RHS>::type
+operator+(const _LHS & _L, const _RHS & _R)
+        { return _DecExpr<_DecNumber::_Add, _LHS, _RHS>(_L, _R); }
+
+template <class _LHS, class _RHS> inline
+typename _Expr_if_operands<_DecNumber::_Sub, _LHS, _RHS>::type
+operator-(const _LHS & _L, const _RHS & _R)
+        { return _DecExpr<_DecNumber::_Sub, _LHS, _RHS>(_L, _R); }
+
+template <class _LHS, class _RHS> inline
+typename _Expr_if_operands<_DecNumber::_Mul, _LHS, _RHS>::type
+operator*(const _LHS & _L, const _RHS & _R)
+        { return _DecExpr<_DecNumber::_Mul, _LHS, _RHS>(_L, _R); }
+
+template <class _LHS, class _RHS> inline
+typename _Expr_if_operands<_DecNumber::_Div, _LHS, _RHS>::type
+operator/(const _LHS & _L, const _RHS & _R)
+        { return _DecExpr<_DecNumber::_Div, _LHS, _RHS>(_L, _R); }
+
+// compound assignment operators
+template <class _LHS, class _RHS> inline
+typename _Assign_if_expr<_LHS, _RHS>::type
+operator+=(_LHS & _L, const _RHS & _R)
+        {
+        _ExprInPlace<_DecNumber::_Add>(_L, _R);
+        return _L;
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Assign_if_expr<_LHS, _RHS>::type
+operator-=(_LHS & _L, const _RHS & _R)
+        {
+        _ExprInPlace<_DecNumber::_Sub>(_L, _R);
+        return _L;
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Assign_if_expr<_LHS, _RHS>::type
+operator*=(_LHS & _L, const _RHS & _R)
+        {
+        _ExprInPlace<_DecNumber::_Mul>(_L, _R);
+        return _L;
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Assign_if_expr<_LHS, _RHS>::type
+operator/=(_LHS & _L, const _RHS & _R)
+        {
+        _ExprInPlace<_DecNumber::_Div>(_L, _R);
+        return _L;
+        }
+
+// relational operators
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator==(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Eq>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator!=(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Ne>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator<(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Lt>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator>(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Gt>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator<=(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Le>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+template <class _LHS, class _RHS> inline
+typename _Compare_if_expr<_LHS, _RHS>::type
+operator>=(const _LHS & _L, const _RHS & _R)
+        {
+        return _DecNumber::_Compare<_DecNumber::_Ge>(_ExprOperand(_L),
+                                                     _ExprOperand(_R));
+        }
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECEXPR_H */
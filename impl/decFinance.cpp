@@ -0,0 +1,429 @@
+/* ------------------------------------------------------------------ */
+/* decFinance.cpp source file                                         */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <vector>
+
+#include "decfinance"
+
+namespace std {
+namespace decimal {
+
+// digits carried beyond those of the format
+static const int _GuardDigits = 9;
+
+// iterations of Newton's method from the guess, and of the bracketed
+// search that follows if it fails
+static const int _NewtonSteps = 50;
+static const int _BracketSteps = 500;
+
+template <class _Fmt> struct _FinanceFmt;
+
+template <> struct _FinanceFmt<decimal64> {
+        enum { _Digits = 16 };
+};
+
+template <> struct _FinanceFmt<decimal128> {
+        enum { _Digits = 34 };
+};
+
+// the working context for a format of _Digits digits
+struct _FinanceContext : _ContextBase {
+        explicit _FinanceContext(int _Digits) :
+                _ContextBase(false)
+                {
+                decContextDefault(this, DEC_INIT_BASE);
+                digits = _Digits + _GuardDigits;
+                emax = DEC_MAX_EMAX;
+                emin = DEC_MIN_EMIN;
+                traps = 0;
+                _GetRoundingMode();
+                }
+};
+
+static _DecNumber _Add(const _DecNumber & _L, const _DecNumber & _R,
+                       decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberAdd(&_Res, &_L, &_R, &_C);
+        return _Res;
+        }
+
+static _DecNumber _Sub(const _DecNumber & _L, const _DecNumber & _R,
+                       decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberSubtract(&_Res, &_L, &_R, &_C);
+        return _Res;
+        }
+
+static _DecNumber _Mul(const _DecNumber & _L, const _DecNumber & _R,
+                       decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberMultiply(&_Res, &_L, &_R, &_C);
+        return _Res;
+        }
+
+static _DecNumber _Div(const _DecNumber & _L, const _DecNumber & _R,
+                       decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberDivide(&_Res, &_L, &_R, &_C);
+        return _Res;
+        }
+
+static _DecNumber _Abs(const _DecNumber & _X, decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberAbs(&_Res, &_X, &_C);
+        return _Res;
+        }
+
+// -1, 0 or 1 as _L is less than, equal to or greater than _R; both
+// must be finite
+static int _Compare(const _DecNumber & _L, const _DecNumber & _R,
+                    decContext & _C)
+        {
+        _DecNumber _Res;
+        decNumberCompare(&_Res, &_L, &_R, &_C);
+        return _Res._IsZero() ? 0 : _Res._IsNeg() ? -1 : 1;
+        }
+
+static _DecNumber _NaN()
+        {
+        _DecNumber _Res;
+        _Res.bits = DECNAN;
+        return _Res;
+        }
+
+// the flows, as decNumbers
+template <class _Fmt>
+static void _Convert(const _Fmt * _Flows, std::size_t _Count,
+                     std::vector<_DecNumber> & _Out)
+        {
+        _Out.reserve(_Count);
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Out.push_back(_DecNumber(_Flows[_I])); }
+        }
+
+// The present value of the flows at _Rate, and its derivative with
+// respect to _Rate if _Deriv is not null, by Horner's rule in the
+// discount factor 1 / (1 + _Rate).  Returns false if _Rate is not
+// greater than -1.
+static bool _PresentValue(const _DecNumber & _Rate,
+                          const std::vector<_DecNumber> & _Flows,
+                          decContext & _C, _DecNumber & _Value,
+                          _DecNumber * _Deriv)
+        {
+        const _DecNumber _One(1);
+        const _DecNumber _Base = _Add(_One, _Rate, _C);
+        if (!_Base._IsFinite() || _Base._IsZero() || _Base._IsNeg())
+                { return false; }
+        const _DecNumber _V = _Div(_One, _Base, _C);
+
+        _DecNumber _P, _D;
+        for (std::size_t _I = _Flows.size(); _I-- != 0; )
+                {
+                if (_Deriv != 0)
+                        { _D = _Add(_Mul(_D, _V, _C), _P, _C); }
+                _P = _Add(_Mul(_P, _V, _C), _Flows[_I], _C);
+                }
+        _Value = _P;
+        if (_Deriv != 0)
+                {
+                // d/dr of V is -V^2
+                *_Deriv = _Mul(_D, _Mul(_V, _V, _C), _C);
+                decNumberMinus(_Deriv, _Deriv, &_C);
+                }
+        return true;
+        }
+
+template <class _Fmt>
+static _Fmt _Round(const _DecNumber & _X,
+                   typename _FmtTraits<_Fmt>::_Context & _Ctxt)
+        {
+        _Fmt _Res;
+        _FmtTraits<_Fmt>::_FromNumber(&_Res, _X, &_Ctxt);
+        return _Res;
+        }
+
+template <class _Fmt>
+static void _Npv(const _Fmt * _Rates, std::size_t _NRates,
+                 const _Fmt * _Flows, std::size_t _Count, _Fmt * _Out)
+        {
+        _FinanceContext _C(_FinanceFmt<_Fmt>::_Digits);
+        typename _FmtTraits<_Fmt>::_Context _Ctxt;
+        std::vector<_DecNumber> _F;
+        _Convert(_Flows, _Count, _F);
+
+        for (std::size_t _I = 0; _I != _NRates; ++_I)
+                {
+                _DecNumber _Value;
+                if (!_PresentValue(_DecNumber(_Rates[_I]), _F, _C, _Value, 0))
+                        {
+                        _Value = _NaN();
+                        _Ctxt.status |= DEC_Invalid_operation;
+                        }
+                _Out[_I] = _Round<_Fmt>(_Value, _Ctxt);
+                }
+        }
+
+// Returns true if the step _Step from _X is within the tolerance _Tol
+// of the format, relative to _X if it is more than one.
+static bool _Converged(const _DecNumber & _Step, const _DecNumber & _X,
+                       const _DecNumber & _Tol, decContext & _C)
+        {
+        const _DecNumber _One(1);
+        _DecNumber _Scale = _Abs(_X, _C);
+        if (_Compare(_Scale, _One, _C) < 0)
+                { _Scale = _One; }
+        return _Compare(_Abs(_Step, _C), _Mul(_Tol, _Scale, _C), _C) <= 0;
+        }
+
+// the internal rate of return, or a NaN
+static _DecNumber _InternalRate(const std::vector<_DecNumber> & _Flows,
+                                const _DecNumber & _Guess, int _Digits,
+                                decContext & _C)
+        {
+        const _DecNumber _Tol(1ULL, -(_Digits + 2), false);
+        _DecNumber _R = _Guess, _F, _DF;
+
+        // Newton's method from the guess
+        for (int _K = 0; _K != _NewtonSteps; ++_K)
+                {
+                if (!_PresentValue(_R, _Flows, _C, _F, &_DF) ||
+                    !_F._IsFinite() || _DF._IsZero() || !_DF._IsFinite())
+                        { break; }
+                if (_F._IsZero())
+                        { return _R; }
+                const _DecNumber _Step = _Div(_F, _DF, _C);
+                _R = _Sub(_R, _Step, _C);
+                if (_Converged(_Step, _R, _Tol, _C))
+                        { return _R; }
+                }
+
+        // bracket a change of sign, from just above -1 upwards
+        _DecNumber _Lo(99ULL, -2, true), _Hi(1), _FLo, _FHi;
+        if (!_PresentValue(_Lo, _Flows, _C, _FLo, 0) ||
+            !_PresentValue(_Hi, _Flows, _C, _FHi, 0))
+                { return _NaN(); }
+        const _DecNumber _Two(2), _Limit(1000000);
+        while (_FLo._IsNeg() == _FHi._IsNeg() && !_FHi._IsZero())
+                {
+                if (_Compare(_Hi, _Limit, _C) > 0 || !_FHi._IsFinite())
+                        { return _NaN(); }
+                _Hi = _Mul(_Hi, _Two, _C);
+                _PresentValue(_Hi, _Flows, _C, _FHi, 0);
+                }
+        if (_FHi._IsZero())
+                { return _Hi; }
+
+        // Newton steps that stay within the bracket, else bisection
+        _R = _Div(_Add(_Lo, _Hi, _C), _Two, _C);
+        for (int _K = 0; _K != _BracketSteps; ++_K)
+                {
+                _PresentValue(_R, _Flows, _C, _F, &_DF);
+                if (_F._IsZero())
+                        { return _R; }
+                if (_F._IsNeg() == _FLo._IsNeg())
+                        { _Lo = _R; }
+                else
+                        { _Hi = _R; }
+
+                _DecNumber _Next, _Step;
+                if (!_DF._IsZero())
+                        {
+                        _Step = _Div(_F, _DF, _C);
+                        _Next = _Sub(_R, _Step, _C);
+                        }
+                if (_DF._IsZero() || _Compare(_Next, _Lo, _C) <= 0 ||
+                    _Compare(_Next, _Hi, _C) >= 0)
+                        {
+                        _Next = _Div(_Add(_Lo, _Hi, _C), _Two, _C);
+                        _Step = _Sub(_R, _Next, _C);
+                        }
+                _R = _Next;
+                if (_Converged(_Step, _R, _Tol, _C))
+                        { return _R; }
+                }
+        return _NaN();
+        }
+
+template <class _Fmt>
+static _Fmt _Irr(const _Fmt * _Flows, std::size_t _Count, _Fmt _Guess)
+        {
+        _FinanceContext _C(_FinanceFmt<_Fmt>::_Digits);
+        typename _FmtTraits<_Fmt>::_Context _Ctxt;
+        std::vector<_DecNumber> _F;
+        _Convert(_Flows, _Count, _F);
+
+        const _DecNumber _R = _InternalRate(_F, _DecNumber(_Guess),
+                                            _FinanceFmt<_Fmt>::_Digits, _C);
+        if (_R._IsNAN())
+                { _Ctxt.status |= DEC_Invalid_operation; }
+        return _Round<_Fmt>(_R, _Ctxt);
+        }
+
+// the payment that repays _Principal over _Periods periods at _Rate,
+// or a NaN
+static _DecNumber _Payment(const _DecNumber & _Rate, int _Periods,
+                           const _DecNumber & _Principal, decContext & _C)
+        {
+        if (_Periods <= 0 || !_Rate._IsFinite() || !_Principal._IsFinite())
+                { return _NaN(); }
+        const _DecNumber _One(1), _N(_Periods);
+        if (!_Rate._IsZero())
+                {
+                // _Principal * _Rate * G / (G - 1), for G = (1 + _Rate)^n
+                _DecNumber _G;
+                const _DecNumber _Base = _Add(_One, _Rate, _C);
+                decNumberPower(&_G, &_Base, &_N, &_C);
+                const _DecNumber _Den = _Sub(_G, _One, _C);
+                if (!_Den._IsZero())
+                        {
+                        return _Div(_Mul(_Mul(_Principal, _Rate, _C), _G, _C),
+                                    _Den, _C);
+                        }
+                // a rate too small to register at this precision
+                }
+        return _Div(_Principal, _N, _C);
+        }
+
+template <class _Fmt>
+static void _AnnuityPayment(const _Fmt * _Rates, const int * _Periods,
+                            const _Fmt * _Principals, std::size_t _Count,
+                            _Fmt * _Out)
+        {
+        _FinanceContext _C(_FinanceFmt<_Fmt>::_Digits);
+        typename _FmtTraits<_Fmt>::_Context _Ctxt;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                const _DecNumber _P = _Payment(_DecNumber(_Rates[_I]),
+                                               _Periods[_I],
+                                               _DecNumber(_Principals[_I]),
+                                               _C);
+                if (_P._IsNAN())
+                        { _Ctxt.status |= DEC_Invalid_operation; }
+                _Out[_I] = _Round<_Fmt>(_P, _Ctxt);
+                }
+        }
+
+template <class _Fmt>
+static void _Schedule(_Fmt _Rate, int _Periods, _Fmt _Principal,
+                      int _Quantum, amortization_row<_Fmt> * _Out)
+        {
+        _FinanceContext _C(_FinanceFmt<_Fmt>::_Digits);
+        typename _FmtTraits<_Fmt>::_Context _Ctxt;
+        const _DecNumber _R(_Rate), _Q(1ULL, _Quantum, false);
+        _DecNumber _Balance(_Principal);
+
+        _DecNumber _Pay = _Payment(_R, _Periods, _Balance, _C);
+        decNumberQuantize(&_Pay, &_Pay, &_Q, &_C);
+        if (_Pay._IsNAN())
+                { _Ctxt.status |= DEC_Invalid_operation; }
+
+        for (int _K = 0; _K < _Periods; ++_K)
+                {
+                _DecNumber _Interest = _Mul(_Balance, _R, _C), _Part;
+                decNumberQuantize(&_Interest, &_Interest, &_Q, &_C);
+                if (_K == _Periods - 1)
+                        {
+                        _Part = _Balance;
+                        _Pay = _Add(_Interest, _Part, _C);
+                        }
+                else
+                        { _Part = _Sub(_Pay, _Interest, _C); }
+                _Balance = _Sub(_Balance, _Part, _C);
+
+                _Out[_K].payment = _Round<_Fmt>(_Pay, _Ctxt);
+                _Out[_K].interest = _Round<_Fmt>(_Interest, _Ctxt);
+                _Out[_K].principal = _Round<_Fmt>(_Part, _Ctxt);
+                _Out[_K].balance = _Round<_Fmt>(_Balance, _Ctxt);
+                }
+        }
+
+decimal64 npv(decimal64 _Rate, const decimal64 * _Flows, std::size_t _Count)
+        {
+        decimal64 _Res;
+        _Npv(&_Rate, 1, _Flows, _Count, &_Res);
+        return _Res;
+        }
+
+decimal128 npv(decimal128 _Rate, const decimal128 * _Flows,
+               std::size_t _Count)
+        {
+        decimal128 _Res;
+        _Npv(&_Rate, 1, _Flows, _Count, &_Res);
+        return _Res;
+        }
+
+void npv(const decimal64 * _Rates, std::size_t _NRates,
+         const decimal64 * _Flows, std::size_t _Count, decimal64 * _Out)
+        { _Npv(_Rates, _NRates, _Flows, _Count, _Out); }
+
+void npv(const decimal128 * _Rates, std::size_t _NRates,
+         const decimal128 * _Flows, std::size_t _Count, decimal128 * _Out)
+        { _Npv(_Rates, _NRates, _Flows, _Count, _Out); }
+
+decimal64 irr(const decimal64 * _Flows, std::size_t _Count)
+        { return _Irr(_Flows, _Count, make_decimal64(1LL, -1)); }
+
+decimal64 irr(const decimal64 * _Flows, std::size_t _Count, decimal64 _Guess)
+        { return _Irr(_Flows, _Count, _Guess); }
+
+decimal128 irr(const decimal128 * _Flows, std::size_t _Count)
+        { return _Irr(_Flows, _Count, decimal128(make_decimal64(1LL, -1))); }
+
+decimal128 irr(const decimal128 * _Flows, std::size_t _Count,
+               decimal128 _Guess)
+        { return _Irr(_Flows, _Count, _Guess); }
+
+decimal64 annuity_payment(decimal64 _Rate, int _Periods, decimal64 _Principal)
+        {
+        decimal64 _Res;
+        _AnnuityPayment(&_Rate, &_Periods, &_Principal, 1, &_Res);
+        return _Res;
+        }
+
+decimal128 annuity_payment(decimal128 _Rate, int _Periods,
+                           decimal128 _Principal)
+        {
+        decimal128 _Res;
+        _AnnuityPayment(&_Rate, &_Periods, &_Principal, 1, &_Res);
+        return _Res;
+        }
+
+void annuity_payment(const decimal64 * _Rates, const int * _Periods,
+                     const decimal64 * _Principals, std::size_t _Count,
+                     decimal64 * _Out)
+        { _AnnuityPayment(_Rates, _Periods, _Principals, _Count, _Out); }
+
+void annuity_payment(const decimal128 * _Rates, const int * _Periods,
+                     const decimal128 * _Principals, std::size_t _Count,
+                     decimal128 * _Out)
+        { _AnnuityPayment(_Rates, _Periods, _Principals, _Count, _Out); }
+
+void amortization_schedule(decimal64 _Rate, int _Periods,
+                           decimal64 _Principal, int _Quantum,
+                           amortization_row<decimal64> * _Out)
+        { _Schedule(_Rate, _Periods, _Principal, _Quantum, _Out); }
+
+void amortization_schedule(decimal128 _Rate, int _Periods,
+                           decimal128 _Principal, int _Quantum,
+                           amortization_row<decimal128> * _Out)
+        { _Schedule(_Rate, _Periods, _Principal, _Quantum, _Out); }
+
+} // namespace decimal
+} // namespace std
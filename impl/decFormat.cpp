@@ -0,0 +1,297 @@
+/* ------------------------------------------------------------------ */
+/* decFormat.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <cstring>
+
+#include "impl/decFormat.h"
+#include "impl/decBCD.h"
+
+namespace std {
+namespace decimal {
+
+std::size_t _FormatLayout::_Size() const
+        {
+        std::size_t _Ret = _Sign != 0 ? 1 : 0;
+        if (_Special != 0)
+                { return _Ret + strlen(_Special); }
+        return _Ret + _Count + _IntZeros + (_Point ? 1 : 0) + _FracZeros +
+               _TrailZeros + _ExpLen;
+        }
+
+// the sign and combination field of an encoding, which are the same
+// in DPD and BID
+static unsigned _SignComb(const decimal32 & _V)
+        { return _GetWord(_V) >> 26; }
+
+static unsigned _SignComb(const decimal64 & _V)
+        { return static_cast<unsigned>(_GetWord(_V) >> 58); }
+
+static unsigned _SignComb(const decimal128 & _V)
+        { return static_cast<unsigned>(_GetWord(_V)._Hi >> 58); }
+
+// Rounds the digits of _L, with exponent _Exp, so that the exponent is
+// at least _MinExp.  A carry out of the top digit keeps the number of
+// digits and raises the exponent instead.
+static void _RoundTo(_FormatLayout & _L, int & _Exp, int _MinExp,
+                     unsigned _Sign, rounding _Mode)
+        {
+        if (_Exp >= _MinExp)
+                { return; }
+
+        // the digits kept; none if even the first is below _MinExp
+        const int _Keep = _L._Count - (_MinExp - _Exp);
+        const int _Count = _Keep > 0 ? _Keep : 0;
+        unsigned _First = 0;
+        bool _Sticky = false;
+        for (int _I = _Keep < 0 ? 0 : _Keep; _I != _L._Count; ++_I)
+                {
+                if (_I == _Keep)
+                        { _First = _L._Digits[_I] - '0'; }
+                else if (_L._Digits[_I] != '0')
+                        { _Sticky = true; }
+                }
+        const unsigned _Last = _Count != 0 ? _L._Digits[_Count - 1] - '0' : 0;
+        _Exp = _MinExp;
+        _L._Count = _Count;
+
+        if (_RoundsUp(_Mode, _Sign, _Last, _First, _Sticky))
+                {
+                int _I = _Count;
+                while (_I != 0 && _L._Digits[_I - 1] == '9')
+                        { _L._Digits[--_I] = '0'; }
+                if (_I != 0)
+                        { ++_L._Digits[_I - 1]; }
+                else
+                        {
+                        // a power of ten
+                        _L._Digits[0] = '1';
+                        if (_Count == 0)
+                                { _L._Count = 1; }
+                        else
+                                { ++_Exp; }
+                        }
+                }
+        else if (_Count == 0)
+                {
+                _L._Digits[0] = '0';
+                _L._Count = 1;
+                }
+        }
+
+// writes the exponent _X, with at least _MinDigits digits
+static void _SetExponent(_FormatLayout & _L, char _E, int _X, int _MinDigits)
+        {
+        char _Tmp[8];
+        int _N = 0;
+        unsigned _U = _X < 0 ? -_X : _X;
+        do
+                {
+                _Tmp[_N++] = static_cast<char>('0' + _U % 10);
+                _U /= 10;
+                }
+        while (_U != 0 || _N < _MinDigits);
+
+        _L._ExpText[0] = _E;
+        _L._ExpText[1] = _X < 0 ? '-' : '+';
+        _L._ExpLen = 2;
+        while (_N != 0)
+                { _L._ExpText[_L._ExpLen++] = _Tmp[--_N]; }
+        }
+
+// scientific notation, with _Prec digits after the point
+static void _LayOutSci(_FormatLayout & _L, int _Exp, int _Prec, bool _Alt,
+                       unsigned _Sign, rounding _Mode, char _E,
+                       int _ExpDigits)
+        {
+        _RoundTo(_L, _Exp, _Exp + _L._Count - 1 - _Prec, _Sign, _Mode);
+        _L._IntDigits = 1;
+        _L._IntZeros = 0;
+        _L._Point = _Prec > 0 || _Alt;
+        _L._FracZeros = 0;
+        _L._TrailZeros = _Prec - (_L._Count - 1);
+        _SetExponent(_L, _E, _Exp + _L._Count - 1, _ExpDigits);
+        }
+
+// fixed notation, with _Prec digits after the point
+static void _LayOutFixed(_FormatLayout & _L, int _Exp, int _Prec, bool _Alt,
+                         unsigned _Sign, rounding _Mode)
+        {
+        _RoundTo(_L, _Exp, -_Prec, _Sign, _Mode);
+        _L._FracZeros = 0;
+        if (_Exp >= 0)
+                {
+                _L._IntDigits = _L._Count;
+                _L._IntZeros = _Exp;
+                _L._TrailZeros = _Prec;
+                }
+        else
+                {
+                if (_L._Count > -_Exp)
+                        {
+                        _L._IntDigits = _L._Count + _Exp;
+                        _L._IntZeros = 0;
+                        }
+                else
+                        {
+                        _L._IntDigits = 0;
+                        _L._IntZeros = 1;
+                        _L._FracZeros = -_Exp - _L._Count;
+                        }
+                _L._TrailZeros = _Prec + _Exp;
+                }
+        _L._Point = _Prec > 0 || _Alt;
+        _L._ExpLen = 0;
+        }
+
+// general notation, with _Prec significant digits
+static void _LayOutGeneral(_FormatLayout & _L, int _Exp, int _Prec,
+                           bool _Alt, unsigned _Sign, rounding _Mode,
+                           char _E)
+        {
+        if (_Prec == 0)
+                { _Prec = 1; }
+        _RoundTo(_L, _Exp, _Exp + _L._Count - _Prec, _Sign, _Mode);
+        const int _X = _Exp + _L._Count - 1;
+        if (!_Alt)
+                {
+                while (_L._Count > 1 && _L._Digits[_L._Count - 1] == '0')
+                        {
+                        --_L._Count;
+                        ++_Exp;
+                        }
+                }
+
+        if (_X >= -4 && _X < _Prec)
+                {
+                _LayOutFixed(_L, _Exp, _Alt ? _Prec - 1 - _X :
+                                              (_Exp < 0 ? -_Exp : 0),
+                             _Alt, _Sign, _Mode);
+                }
+        else
+                {
+                _LayOutSci(_L, _Exp, _Alt ? _Prec - 1 : _L._Count - 1,
+                           _Alt, _Sign, _Mode, _E, 2);
+                }
+        }
+
+template <class _Fmt>
+static void _LayOutFmt(const _Fmt & _V, const _FormatSpec & _Spec,
+                       _FormatLayout & _L)
+        {
+        typedef _BCDFmt<_Fmt> _P;
+        const bool _Upper = _Spec._Type >= 'A' && _Spec._Type <= 'Z';
+
+        const unsigned _SC = _SignComb(_V);
+        const unsigned _Sign = _SC >> 5;
+        _L._Sign = _Sign ? '-' : _Spec._Sign == '-' ? 0 : _Spec._Sign;
+        _L._Special = 0;
+        _L._Count = 0;
+        _L._IntDigits = 0;
+        _L._IntZeros = 0;
+        _L._Point = false;
+        _L._FracZeros = 0;
+        _L._TrailZeros = 0;
+        _L._ExpLen = 0;
+
+        int _Exp;
+        unsigned _S, _G[_P::_Declets + 1];
+        if (!_Disassemble(_V, _S, _Exp, _G))
+                {
+                if ((_SC & 0x1F) == 0x1F)
+                        { _L._Special = _Upper ? "NAN" : "nan"; }
+                else
+                        { _L._Special = _Upper ? "INF" : "inf"; }
+                return;
+                }
+
+        // the digits, most significant first
+        const int _N = static_cast<int>(_SigDigits(_G, _P::_Declets + 1));
+        for (int _I = 0; _I < _N; ++_I)
+                {
+                const int _K = _N - 1 - _I;
+                _L._Digits[_I] = static_cast<char>(
+                        '0' + ((_G[_K / 3] >> (4 * (_K % 3))) & 0xF));
+                }
+        _L._Count = _N;
+        if (_N == 0)
+                {
+                // only the plain and 'a' forms show the exponent of a zero
+                _L._Digits[0] = '0';
+                _L._Count = 1;
+                if (_Spec._Type != 0 && _Spec._Type != 'a' &&
+                    _Spec._Type != 'A')
+                        { _Exp = 0; }
+                }
+
+        const rounding _Mode = _ContextDefault(false).round;
+        const char _E = _Upper ? 'E' : 'e';
+        const int _Prec = _Spec._Prec;
+        switch (_Spec._Type)
+                {
+                case 'a':
+                case 'A':
+                        _LayOutSci(_L, _Exp, _Prec < 0 ? _L._Count - 1 : _Prec,
+                                   _Spec._Alt, _Sign, _Mode, _E, 2);
+                        break;
+                case 'e':
+                case 'E':
+                        _LayOutSci(_L, _Exp, _Prec < 0 ? 6 : _Prec,
+                                   _Spec._Alt, _Sign, _Mode, _E, 2);
+                        break;
+                case 'f':
+                case 'F':
+                        _LayOutFixed(_L, _Exp, _Prec < 0 ? 6 : _Prec,
+                                     _Spec._Alt, _Sign, _Mode);
+                        break;
+                case 'g':
+                case 'G':
+                        _LayOutGeneral(_L, _Exp, _Prec < 0 ? 6 : _Prec,
+                                       _Spec._Alt, _Sign, _Mode, _E);
+                        break;
+                default:
+                        if (_Prec >= 0)
+                                {
+                                _LayOutGeneral(_L, _Exp, _Prec, _Spec._Alt,
+                                               _Sign, _Mode, _E);
+                                }
+                        else if (_Exp <= 0 && _Exp + _L._Count - 1 >= -6)
+                                {
+                                // as decNumberToString
+                                _LayOutFixed(_L, _Exp, -_Exp, _Spec._Alt,
+                                             _Sign, _Mode);
+                                }
+                        else
+                                {
+                                _LayOutSci(_L, _Exp, _L._Count - 1,
+                                           _Spec._Alt, _Sign, _Mode, 'E', 1);
+                                }
+                        break;
+                }
+        }
+
+void _LayOut(const decimal32 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L)
+        { _LayOutFmt(_V, _Spec, _L); }
+
+void _LayOut(const decimal64 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L)
+        { _LayOutFmt(_V, _Spec, _L); }
+
+void _LayOut(const decimal128 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L)
+        { _LayOutFmt(_V, _Spec, _L); }
+
+} // namespace decimal
+} // namespace std
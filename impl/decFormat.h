@@ -0,0 +1,73 @@
+/* ------------------------------------------------------------------ */
+/* decFormat.h header                                                 */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#ifndef _DECFORMAT_H
+#define _DECFORMAT_H
+
+#include <cstddef>
+
+#include "decimal"
+
+namespace std {
+namespace decimal {
+
+// A parsed format specification (see <decformat>).  The fill
+// character is kept by the formatter, as it may be a wide character.
+struct _FormatSpec {
+        char _Align;            // '<', '>', '^', or 0 for the default
+        char _Sign;             // '+', ' ' or '-'
+        bool _Alt;              // '#': always write the decimal point
+        bool _ZeroPad;          // '0': pad with zeros after the sign
+        int  _Width;            // 0 if none
+        int  _Prec;             // -1 if none
+        int  _WidthArg;         // argument of a dynamic width, or -1
+        int  _PrecArg;          // argument of a dynamic precision, or -1
+        char _Type;             // 'a', 'e', 'f', 'g' (or upper case), or 0
+};
+
+// The pieces of a formatted value, in output order.  Only _Sign and
+// _Special are set for an infinity or NaN.  Otherwise the text is
+// _IntDigits digits, _IntZeros zeros, the decimal point (if _Point),
+// _FracZeros zeros, the remaining digits, _TrailZeros zeros, and
+// _ExpText, with the digits taken from _Digits.
+struct _FormatLayout {
+        char         _Sign;     // 0 if none
+        const char * _Special;  // "inf", "NAN", ..., or 0
+        char         _Digits[34];
+        int          _Count;
+        int          _IntDigits;
+        int          _IntZeros;
+        bool         _Point;
+        int          _FracZeros;
+        int          _TrailZeros;
+        char         _ExpText[8];
+        int          _ExpLen;
+
+        // the length of the text
+        std::size_t _Size() const;
+};
+
+// lay out _V for the specification _Spec
+void _LayOut(const decimal32 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L);
+void _LayOut(const decimal64 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L);
+void _LayOut(const decimal128 & _V, const _FormatSpec & _Spec,
+             _FormatLayout & _L);
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECFORMAT_H */
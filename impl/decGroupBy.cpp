@@ -0,0 +1,310 @@
+/* ------------------------------------------------------------------ */
+/* decGroupBy.cpp source file                                         */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+
+#include "decgroupby"
+#include "cdecmath"
+
+namespace std {
+namespace decimal {
+
+// sums are held as coefficients of decimal128 values
+typedef _KernelFmt<decimal128> _GroupSum;
+
+uint64_t _HashBytes(const char * _P, std::size_t _Count)
+        {
+        // FNV-1a, then mixed as an integer key
+        uint64_t _H = 0xCBF29CE484222325ULL;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                {
+                _H ^= static_cast<unsigned char>(_P[_I]);
+                _H *= 0x100000001B3ULL;
+                }
+        return _HashInt(_H);
+        }
+
+static _Uint128 _Widen(uint64_t _C)
+        { return _MakeUint128(0, _C); }
+
+static const _Uint128 & _Widen(const _Uint128 & _C)
+        { return _C; }
+
+// (-1)^_Sign * _C * 10^_E, with _C below 10^34
+static decimal128 _WideValue(unsigned _Sign, const _Uint128 & _C, int _E)
+        {
+        _Native128 _N;
+        _N._Sign = _Sign;
+        _N._Kind = _NativeFinite;
+        _N._Exp = _E;
+        _N._Coeff = _C;
+        decimal128 _V;
+        _Pack(_V, _N);
+        return _V;
+        }
+
+// the accumulator of _S, taking one and moving the sum into it if the
+// sum is not held by one yet
+template <class _Dec>
+static decimal_accumulator & _Spill(_GroupState<_Dec> & _S,
+                                    std::vector<decimal_accumulator> & _Spills)
+        {
+        if (_S._Spill == 0)
+                {
+                _Spills.push_back(decimal_accumulator());
+                _S._Spill = static_cast<uint32_t>(_Spills.size());
+                for (unsigned _Sign = 0; _Sign != 2; ++_Sign)
+                        {
+                        // zeros too, for the sign and exponent of a zero sum
+                        if ((_S._Signs >> _Sign & 1) != 0)
+                                {
+                                _Spills.back() += _WideValue(
+                                        _Sign, _S._Mag[_Sign], _S._Exp);
+                                }
+                        }
+                }
+        return _Spills[_S._Spill - 1];
+        }
+
+// Adds (-1)^_Sign * _C * 10^_E to the integer sum of _S, unless the sum
+// or either magnitude would then need more than 34 digits.  The sum is
+// unchanged when this fails, though it may be held at a lower exponent.
+template <class _Dec>
+static bool _AddExact(_GroupState<_Dec> & _S, unsigned _Sign,
+                      const _Uint128 & _C, int _E)
+        {
+        if (_S._Signs == 0)
+                { _S._Exp = _E; }
+        _Uint128 _T = _C;
+        if (_E != _S._Exp)
+                {
+                if (_E < _S._Exp)
+                        {
+                        _Uint128 _Pos, _Neg;
+                        const int _D = _S._Exp - _E;
+                        if (!_GroupSum::_Scale(_S._Mag[0], _D, _Pos) ||
+                            !_GroupSum::_Scale(_S._Mag[1], _D, _Neg))
+                                { return false; }
+                        _S._Mag[0] = _Pos;
+                        _S._Mag[1] = _Neg;
+                        _S._Exp = _E;
+                        }
+                if (!_GroupSum::_Scale(_C, _E - _S._Exp, _T))
+                        { return false; }
+                }
+        _T = _GroupSum::_Add(_S._Mag[_Sign], _T);
+        if (!_GroupSum::_Fits(_T))
+                { return false; }
+        _S._Mag[_Sign] = _T;
+        _S._Signs |= 1U << _Sign;
+        return true;
+        }
+
+// _KernelOrder(_A, _B), compared as signed integers when both are
+// finite decimal64 values with the same exponent, not both zero, as the
+// amounts of a group mostly are
+static int _Order(const _Native64 & _A, const _Native64 & _B)
+        {
+        if (_A._Kind != _NativeFinite || _B._Kind != _NativeFinite ||
+            _A._Exp != _B._Exp || (_A._Coeff | _B._Coeff) == 0)
+                { return _KernelOrder<_KernelFmt<decimal64> >(_A, _B); }
+        const int64_t _L = _A._Sign ? -static_cast<int64_t>(_A._Coeff) :
+                                      static_cast<int64_t>(_A._Coeff);
+        const int64_t _R = _B._Sign ? -static_cast<int64_t>(_B._Coeff) :
+                                      static_cast<int64_t>(_B._Coeff);
+        return _L < _R ? -1 : _R < _L ? 1 : 0;
+        }
+
+static int _Order(const _Native128 & _A, const _Native128 & _B)
+        { return _KernelOrder<_KernelFmt<decimal128> >(_A, _B); }
+
+// takes a value other than a NaN into the minimum and maximum
+template <class _Dec>
+static void _AddExtreme(_GroupState<_Dec> & _S,
+                        const typename _GroupState<_Dec>::_Native & _N)
+        {
+        if ((_S._Flags & _GroupState<_Dec>::_HasValue) == 0)
+                {
+                _S._Min = _S._Max = _N;
+                _S._Flags |= _GroupState<_Dec>::_HasValue;
+                }
+        else if (_Order(_N, _S._Min) < 0)
+                { _S._Min = _N; }
+        else if (_Order(_N, _S._Max) > 0)
+                { _S._Max = _N; }
+        }
+
+// keeps the first signaling NaN, or failing that the first quiet one
+template <class _Dec>
+static void _AddNaN(_GroupState<_Dec> & _S, const _Dec & _V, bool _Signal)
+        {
+        typedef _GroupState<_Dec> _St;
+        if (_Signal ? (_S._Flags & _St::_HasSNaN) == 0 :
+                      (_S._Flags & (_St::_HasQNaN | _St::_HasSNaN)) == 0)
+                {
+                _S._NaN = _V;
+                _S._Flags |= _Signal ? _St::_HasSNaN : _St::_HasQNaN;
+                }
+        }
+
+template <class _Dec>
+static void _Add(_GroupState<_Dec> & _S,
+                 std::vector<decimal_accumulator> & _Spills, const _Dec & _V)
+        {
+        typename _GroupState<_Dec>::_Native _N;
+        _Unpack(_V, _N);
+        ++_S._Count;
+        if (_N._Kind == _NativeQNaN || _N._Kind == _NativeSNaN)
+                { _AddNaN(_S, _V, _N._Kind == _NativeSNaN); }
+        else
+                { _AddExtreme(_S, _N); }
+
+        if (_S._Spill != 0 || _N._Kind != _NativeFinite ||
+            !_AddExact(_S, _N._Sign, _Widen(_N._Coeff), _N._Exp))
+                { _Spill(_S, _Spills) += _V; }
+        }
+
+template <class _Dec>
+static void _Merge(_GroupState<_Dec> & _S,
+                   std::vector<decimal_accumulator> & _Spills,
+                   const _GroupState<_Dec> & _From,
+                   const std::vector<decimal_accumulator> & _FromSpills)
+        {
+        typedef _GroupState<_Dec> _St;
+        _S._Count += _From._Count;
+        if ((_From._Flags & _St::_HasSNaN) != 0)
+                { _AddNaN(_S, _From._NaN, true); }
+        else if ((_From._Flags & _St::_HasQNaN) != 0)
+                { _AddNaN(_S, _From._NaN, false); }
+        if ((_From._Flags & _St::_HasValue) != 0)
+                {
+                _AddExtreme(_S, _From._Min);
+                _AddExtreme(_S, _From._Max);
+                }
+
+        if (_From._Spill != 0)
+                {
+                _Spill(_S, _Spills) += _FromSpills[_From._Spill - 1];
+                return;
+                }
+        for (unsigned _Sign = 0; _Sign != 2; ++_Sign)
+                {
+                if ((_From._Signs >> _Sign & 1) == 0)
+                        { continue; }
+                if (_S._Spill != 0 || !_AddExact(_S, _Sign,
+                                                 _From._Mag[_Sign],
+                                                 _From._Exp))
+                        {
+                        _Spill(_S, _Spills) += _WideValue(
+                                _Sign, _From._Mag[_Sign], _From._Exp);
+                        }
+                }
+        }
+
+static void _Narrow(const decimal128 & _V, decimal64 & _Out)
+        { _Out = decimal64(_V); }
+
+static void _Narrow(const decimal128 & _V, decimal128 & _Out)
+        { _Out = _V; }
+
+static void _Read(const decimal_accumulator & _Acc, decimal64 & _Out)
+        { _Out = _Acc.to_decimal64(); }
+
+static void _Read(const decimal_accumulator & _Acc, decimal128 & _Out)
+        { _Out = _Acc.to_decimal128(); }
+
+template <class _Dec>
+static void _Result(const _GroupState<_Dec> & _S,
+                    const std::vector<decimal_accumulator> & _Spills,
+                    decimal_aggregate<_Dec> & _Out)
+        {
+        typedef _GroupState<_Dec> _St;
+        _Out.count = _S._Count;
+        if (_S._Spill != 0)
+                { _Read(_Spills[_S._Spill - 1], _Out.sum); }
+        else if (_S._Signs == 0)
+                { _Out.sum = _Dec(0); }
+        else
+                {
+                // the exact sum fits decimal128, and is rounded once to
+                // the format; a zero is signed as by decimal_accumulator
+                unsigned _Sign;
+                _Uint128 _C;
+                if (_S._Mag[1] < _S._Mag[0])
+                        {
+                        _Sign = 0;
+                        _C = _GroupSum::_Sub(_S._Mag[0], _S._Mag[1]);
+                        }
+                else if (_S._Mag[0] < _S._Mag[1])
+                        {
+                        _Sign = 1;
+                        _C = _GroupSum::_Sub(_S._Mag[1], _S._Mag[0]);
+                        }
+                else
+                        {
+                        _Sign = _S._Signs == 2 || (_S._Signs == 3 &&
+                                fe_dec_getround() == DEC_ROUND_FLOOR);
+                        _C = _MakeUint128(0, 0);
+                        }
+                _Narrow(_WideValue(_Sign, _C, _S._Exp), _Out.sum);
+                }
+
+        if ((_S._Flags & _St::_HasSNaN) != 0 ||
+            (_S._Flags & _St::_HasValue) == 0)
+                {
+                // quieted, and the operation signaled, by fmin and fmax
+                _Out.min = fmin(_S._NaN, _S._NaN);
+                _Out.max = fmax(_S._NaN, _S._NaN);
+                }
+        else
+                {
+                _Pack(_Out.min, _S._Min);
+                _Pack(_Out.max, _S._Max);
+                }
+        }
+
+void _GroupAdd(_GroupState<decimal64> & _S,
+               std::vector<decimal_accumulator> & _Spills,
+               const decimal64 & _V)
+        { _Add(_S, _Spills, _V); }
+
+void _GroupAdd(_GroupState<decimal128> & _S,
+               std::vector<decimal_accumulator> & _Spills,
+               const decimal128 & _V)
+        { _Add(_S, _Spills, _V); }
+
+void _GroupMerge(_GroupState<decimal64> & _S,
+                 std::vector<decimal_accumulator> & _Spills,
+                 const _GroupState<decimal64> & _From,
+                 const std::vector<decimal_accumulator> & _FromSpills)
+        { _Merge(_S, _Spills, _From, _FromSpills); }
+
+void _GroupMerge(_GroupState<decimal128> & _S,
+                 std::vector<decimal_accumulator> & _Spills,
+                 const _GroupState<decimal128> & _From,
+                 const std::vector<decimal_accumulator> & _FromSpills)
+        { _Merge(_S, _Spills, _From, _FromSpills); }
+
+void _GroupResult(const _GroupState<decimal64> & _S,
+                  const std::vector<decimal_accumulator> & _Spills,
+                  decimal_aggregate<decimal64> & _Out)
+        { _Result(_S, _Spills, _Out); }
+
+void _GroupResult(const _GroupState<decimal128> & _S,
+                  const std::vector<decimal_accumulator> & _Spills,
+                  decimal_aggregate<decimal128> & _Out)
+        { _Result(_S, _Spills, _Out); }
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,83 @@
+/* ------------------------------------------------------------------ */
+/* decKernel.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "impl/decKernel.h"
+
+namespace std {
+namespace decimal {
+
+const uint64_t _KernelPow10[20] = {
+        1ULL,
+        10ULL,
+        100ULL,
+        1000ULL,
+        10000ULL,
+        100000ULL,
+        1000000ULL,
+        10000000ULL,
+        100000000ULL,
+        1000000000ULL,
+        10000000000ULL,
+        100000000000ULL,
+        1000000000000ULL,
+        10000000000000ULL,
+        100000000000000ULL,
+        1000000000000000ULL,
+        10000000000000000ULL,
+        100000000000000000ULL,
+        1000000000000000000ULL,
+        10000000000000000000ULL
+};
+
+const _Uint128 _KernelPow10W[35] = {
+        { 0x0000000000000000ULL, 0x0000000000000001ULL },
+        { 0x0000000000000000ULL, 0x000000000000000aULL },
+        { 0x0000000000000000ULL, 0x0000000000000064ULL },
+        { 0x0000000000000000ULL, 0x00000000000003e8ULL },
+        { 0x0000000000000000ULL, 0x0000000000002710ULL },
+        { 0x0000000000000000ULL, 0x00000000000186a0ULL },
+        { 0x0000000000000000ULL, 0x00000000000f4240ULL },
+        { 0x0000000000000000ULL, 0x0000000000989680ULL },
+        { 0x0000000000000000ULL, 0x0000000005f5e100ULL },
+        { 0x0000000000000000ULL, 0x000000003b9aca00ULL },
+        { 0x0000000000000000ULL, 0x00000002540be400ULL },
+        { 0x0000000000000000ULL, 0x000000174876e800ULL },
+        { 0x0000000000000000ULL, 0x000000e8d4a51000ULL },
+        { 0x0000000000000000ULL, 0x000009184e72a000ULL },
+        { 0x0000000000000000ULL, 0x00005af3107a4000ULL },
+        { 0x0000000000000000ULL, 0x00038d7ea4c68000ULL },
+        { 0x0000000000000000ULL, 0x002386f26fc10000ULL },
+        { 0x0000000000000000ULL, 0x016345785d8a0000ULL },
+        { 0x0000000000000000ULL, 0x0de0b6b3a7640000ULL },
+        { 0x0000000000000000ULL, 0x8ac7230489e80000ULL },
+        { 0x0000000000000005ULL, 0x6bc75e2d63100000ULL },
+        { 0x0000000000000036ULL, 0x35c9adc5dea00000ULL },
+        { 0x000000000000021eULL, 0x19e0c9bab2400000ULL },
+        { 0x000000000000152dULL, 0x02c7e14af6800000ULL },
+        { 0x000000000000d3c2ULL, 0x1bcecceda1000000ULL },
+        { 0x0000000000084595ULL, 0x161401484a000000ULL },
+        { 0x000000000052b7d2ULL, 0xdcc80cd2e4000000ULL },
+        { 0x00000000033b2e3cULL, 0x9fd0803ce8000000ULL },
+        { 0x00000000204fce5eULL, 0x3e25026110000000ULL },
+        { 0x00000001431e0faeULL, 0x6d7217caa0000000ULL },
+        { 0x0000000c9f2c9cd0ULL, 0x4674edea40000000ULL },
+        { 0x0000007e37be2022ULL, 0xc0914b2680000000ULL },
+        { 0x000004ee2d6d415bULL, 0x85acef8100000000ULL },
+        { 0x0000314dc6448d93ULL, 0x38c15b0a00000000ULL },
+        { 0x0001ed09bead87c0ULL, 0x378d8e6400000000ULL }
+};
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,312 @@
+/* ------------------------------------------------------------------ */
+/* decKernel.h header                                                 */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+// Arithmetic on unpacked decimal64 and decimal128 values, for the
+// operations over arrays and columns.  Each kernel computes the result
+// of the decNumber operation when it is exact and fits the format, and
+// returns false otherwise; the caller then goes through decNumber.
+
+#ifndef _DECKERNEL_H
+#define _DECKERNEL_H
+
+#include "decimal"
+#include "impl/decNative.h"
+
+namespace std {
+namespace decimal {
+
+// powers of ten, up to 10^19 and 10^34
+extern const uint64_t _KernelPow10[20];
+extern const _Uint128 _KernelPow10W[35];
+
+// _X * _M, which must fit 128 bits
+inline _Uint128 _MulSmall(const _Uint128 & _X, uint64_t _M)
+        {
+        const _Uint128 _Lo = _Mul64(_X._Lo, _M);
+        return _MakeUint128(_X._Hi * _M + _Lo._Hi, _Lo._Lo);
+        }
+
+// The integer arithmetic of the coefficients of each format.  _Scale
+// multiplies a coefficient by 10^_D, and _Mul two coefficients, unless
+// the product has more digits than the format.  The kernels keep to
+// exponents from _Emin, below which decNumber flags a result as
+// subnormal, to _MaxExp, above which it clamps it.
+template <class _Dec>
+struct _KernelFmt;
+
+template <>
+struct _KernelFmt<decimal64> {
+        typedef _FmtTraits<decimal64> _Tr;
+        typedef _Native64 _Native;
+        typedef uint64_t  _Coeff;
+        static const int _Emin   = -383;
+        static const int _MaxExp = 369;
+
+        static bool _IsZero(uint64_t _C)
+                { return _C == 0; }
+        static bool _Fits(uint64_t _C)
+                { return _C < _KernelPow10[16]; }
+        static bool _Scale(uint64_t _C, int _D, uint64_t & _R)
+                {
+                if (_C == 0)
+                        {
+                        _R = 0;
+                        return true;
+                        }
+                if (_D >= 16 || _C >= _KernelPow10[16 - _D])
+                        { return false; }
+                _R = _C * _KernelPow10[_D];
+                return true;
+                }
+        static bool _Mul(uint64_t _L, uint64_t _R, uint64_t & _P)
+                {
+                const _Uint128 _W = _Mul64(_L, _R);
+                _P = _W._Lo;
+                return _W._Hi == 0 && _Fits(_W._Lo);
+                }
+        static uint64_t _Add(uint64_t _L, uint64_t _R)
+                { return _L + _R; }
+        static uint64_t _Sub(uint64_t _L, uint64_t _R)
+                { return _L - _R; }
+        static bool _Narrow(uint64_t _C, uint64_t & _N)
+                {
+                _N = _C;
+                return true;
+                }
+        static uint64_t _Widen(uint64_t _N)
+                { return _N; }
+};
+
+template <>
+struct _KernelFmt<decimal128> {
+        typedef _FmtTraits<decimal128> _Tr;
+        typedef _Native128 _Native;
+        typedef _Uint128   _Coeff;
+        static const int _Emin   = -6143;
+        static const int _MaxExp = 6111;
+
+        static bool _IsZero(const _Uint128 & _C)
+                { return (_C._Hi | _C._Lo) == 0; }
+        static bool _Fits(const _Uint128 & _C)
+                { return _C < _KernelPow10W[34]; }
+        static bool _Scale(const _Uint128 & _C, int _D, _Uint128 & _R)
+                {
+                if (_IsZero(_C))
+                        {
+                        _R = _C;
+                        return true;
+                        }
+                if (_D >= 34 || !(_C < _KernelPow10W[34 - _D]))
+                        { return false; }
+                _R = _D > 19 ? _MulSmall(_MulSmall(_C, _KernelPow10[19]),
+                                         _KernelPow10[_D - 19]) :
+                               _MulSmall(_C, _KernelPow10[_D]);
+                return true;
+                }
+        static bool _Mul(const _Uint128 & _L, const _Uint128 & _R,
+                         _Uint128 & _P)
+                {
+                if (_L._Hi != 0 || _R._Hi != 0)
+                        { return false; }
+                _P = _Mul64(_L._Lo, _R._Lo);
+                return _Fits(_P);
+                }
+        static _Uint128 _Add(const _Uint128 & _L, const _Uint128 & _R)
+                {
+                const uint64_t _Lo = _L._Lo + _R._Lo;
+                return _MakeUint128(_L._Hi + _R._Hi + (_Lo < _R._Lo), _Lo);
+                }
+        static _Uint128 _Sub(const _Uint128 & _L, const _Uint128 & _R)
+                {
+                return _MakeUint128(_L._Hi - _R._Hi - (_L._Lo < _R._Lo),
+                                    _L._Lo - _R._Lo);
+                }
+        static bool _Narrow(const _Uint128 & _C, uint64_t & _N)
+                {
+                _N = _C._Lo;
+                return _C._Hi == 0;
+                }
+        static _Uint128 _Widen(uint64_t _N)
+                { return _MakeUint128(0, _N); }
+};
+
+// the magnitude of _CA * 10^_EA against that of _CB * 10^_EB, neither
+// of them zero
+template <class _M>
+inline int _CompareMagnitudes(const typename _M::_Coeff & _CA, int _EA,
+                             const typename _M::_Coeff & _CB, int _EB)
+        {
+        typename _M::_Coeff _S;
+        if (_EA >= _EB)
+                {
+                if (!_M::_Scale(_CA, _EA - _EB, _S))
+                        { return 1; }
+                return _S < _CB ? -1 : _CB < _S ? 1 : 0;
+                }
+        if (!_M::_Scale(_CB, _EB - _EA, _S))
+                { return -1; }
+        return _CA < _S ? -1 : _S < _CA ? 1 : 0;
+        }
+
+// -1, 0 or 1 as the value _A, not a NaN, comes before, with or after
+// _B in the order of fmax: by value, then, as decNumberMax breaks ties
+// between equal values, positive after negative and by exponent, the
+// larger exponent last for positive values and first for negative ones
+template <class _M>
+inline int _KernelOrder(const typename _M::_Native & _A,
+                        const typename _M::_Native & _B)
+        {
+        const bool _IA = _A._Kind == _NativeInf;
+        const bool _IB = _B._Kind == _NativeInf;
+        if (_IA || _IB)
+                {
+                const int _RA = _IA ? (_A._Sign ? -1 : 1) : 0;
+                const int _RB = _IB ? (_B._Sign ? -1 : 1) : 0;
+                return _RA < _RB ? -1 : _RB < _RA ? 1 : 0;
+                }
+
+        const bool _ZA = _M::_IsZero(_A._Coeff), _ZB = _M::_IsZero(_B._Coeff);
+        int _C = 0;
+        if (_ZA && !_ZB)
+                { _C = _B._Sign ? 1 : -1; }
+        else if ((_ZB && !_ZA) || _A._Sign != _B._Sign)
+                { _C = _A._Sign ? -1 : 1; }
+        else if (!_ZA)
+                {
+                _C = _CompareMagnitudes<_M>(_A._Coeff, _A._Exp, _B._Coeff,
+                                            _B._Exp);
+                if (_A._Sign)
+                        { _C = -_C; }
+                }
+        if (_C != 0 || _A._Exp == _B._Exp)
+                { return _C; }
+        _C = _A._Exp < _B._Exp ? -1 : 1;
+        return _A._Sign ? -_C : _C;
+        }
+
+// The sum of two finite values, with the sign of the second inverted
+// if _Neg is 1.  The coefficient with the larger exponent is scaled to
+// the smaller one, which is the exponent of the exact sum; an exact
+// zero is negative only when rounding toward negative infinity.
+template <class _M>
+inline bool _KernelAdd(unsigned _SA, typename _M::_Coeff _CA, int _EA,
+                       unsigned _SB, typename _M::_Coeff _CB, int _EB,
+                       unsigned _Neg, rounding _Mode, unsigned & _S,
+                       typename _M::_Coeff & _C, int & _E)
+        {
+        _SB ^= _Neg;
+        if (!(_EA > _EB ? _M::_Scale(_CA, _EA - _EB, _CA) :
+                          _M::_Scale(_CB, _EB - _EA, _CB)))
+                { return false; }
+        _E = _EA < _EB ? _EA : _EB;
+        if (_E < _M::_Emin)
+                { return false; }
+        if (_SA == _SB)
+                {
+                _S = _SA;
+                _C = _M::_Add(_CA, _CB);
+                return _M::_Fits(_C);
+                }
+        if (_CA < _CB)
+                {
+                _S = _SB;
+                _C = _M::_Sub(_CB, _CA);
+                }
+        else if (_CB < _CA)
+                {
+                _S = _SA;
+                _C = _M::_Sub(_CA, _CB);
+                }
+        else
+                {
+                _S = _Mode == DEC_ROUND_FLOOR;
+                _C = typename _M::_Coeff();
+                }
+        return true;
+        }
+
+// the product of two finite values
+template <class _M>
+inline bool _KernelMul(unsigned _SA, const typename _M::_Coeff & _CA,
+                       int _EA, unsigned _SB,
+                       const typename _M::_Coeff & _CB, int _EB,
+                       unsigned & _S, typename _M::_Coeff & _C, int & _E)
+        {
+        _S = _SA ^ _SB;
+        _E = _EA + _EB;
+        return _E >= _M::_Emin && _E <= _M::_MaxExp &&
+               _M::_Mul(_CA, _CB, _C);
+        }
+
+// The quotient of two finite values when the divisor divides the
+// dividend, which then has the exponent _EA - _EB.  Only coefficients
+// of up to 64 bits are divided.
+template <class _M>
+inline bool _KernelDiv(unsigned _SA, const typename _M::_Coeff & _CA,
+                       int _EA, unsigned _SB,
+                       const typename _M::_Coeff & _CB, int _EB,
+                       unsigned & _S, typename _M::_Coeff & _C, int & _E)
+        {
+        uint64_t _NA, _NB;
+        if (!_M::_Narrow(_CA, _NA) || !_M::_Narrow(_CB, _NB) || _NB == 0 ||
+            _NA % _NB != 0)
+                { return false; }
+        _S = _SA ^ _SB;
+        _C = _M::_Widen(_NA / _NB);
+        _E = _EA - _EB;
+        return _E >= _M::_Emin && _E <= _M::_MaxExp;
+        }
+
+// A finite value quantized to the exponent _Q, rounding in _Mode, with
+// the DEC_Rounded and DEC_Inexact flags of the rounding in _Status.
+// Only coefficients of up to 64 bits are rounded.
+template <class _M>
+inline bool _KernelQuantize(unsigned _SA, const typename _M::_Coeff & _CA,
+                            int _EA, int _Q, rounding _Mode,
+                            typename _M::_Coeff & _C, uint32_t & _Status)
+        {
+        _Status = 0;
+        if (_Q < _M::_Emin || _Q > _M::_MaxExp)
+                { return false; }
+        if (_Q <= _EA || _M::_IsZero(_CA))
+                { return _M::_Scale(_CA, _Q < _EA ? _EA - _Q : 0, _C); }
+
+        uint64_t _N;
+        if (!_M::_Narrow(_CA, _N))
+                { return false; }
+        const int _D = _Q - _EA;
+        uint64_t _R = 0;
+        unsigned _First = 0;
+        bool _Sticky = _N != 0;
+        if (_D <= 20)
+                {
+                // the digits below the first one dropped
+                const uint64_t _Low = _KernelPow10[_D - 1];
+                _R = _D == 20 ? 0 : _N / (_Low * 10);
+                _First = static_cast<unsigned>(_N / _Low % 10);
+                _Sticky = _N % _Low != 0;
+                }
+        _Status = DEC_Rounded | (_First != 0 || _Sticky ? DEC_Inexact : 0);
+        if (_RoundsUp(_Mode, _SA, static_cast<unsigned>(_R % 10), _First,
+                      _Sticky))
+                { ++_R; }
+        _C = _M::_Widen(_R);
+        return _M::_Fits(_C);
+        }
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECKERNEL_H */
@@ -0,0 +1,273 @@
+/* ------------------------------------------------------------------ */
+/* decLoader.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "decloader"
+#include "deccharconv"
+#include "impl/decThread.h"
+
+#ifdef _DEC_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* def _DEC_HAS_MMAP */
+
+namespace std {
+namespace decimal {
+
+// chunks are at least this large, so that small files are not split
+// into more pieces than is worthwhile
+static const std::size_t _MinChunkBytes = 1UL << 20;
+
+// chunks per thread, so that uneven chunks balance out
+static const std::size_t _ChunksPerThread = 8;
+
+static std::size_t _CountLines(const char * _Beg, const char * _End)
+        {
+        std::size_t _N = 0;
+        while (_Beg != _End)
+                {
+                const void * _Nl = std::memchr(_Beg, '\n', _End - _Beg);
+                if (_Nl == 0)
+                        { return _N + 1; } // unterminated last line
+                _Beg = static_cast<const char *>(_Nl) + 1;
+                ++_N;
+                }
+        return _N;
+        }
+
+static inline bool _IsBlank(char _C)
+        { return _C == ' ' || _C == '\t' || _C == '\r'; }
+
+decimal_file::decimal_file(const char * _Path) :
+        _Data(0), _Length(0), _Mapped(false), _Error(0)
+        {
+#ifdef _DEC_HAS_MMAP
+        const int _Fd = ::open(_Path, O_RDONLY);
+        if (_Fd < 0)
+                {
+                _Error = errno;
+                return;
+                }
+        struct stat _St;
+        if (::fstat(_Fd, &_St) != 0)
+                { _Error = errno; }
+        else if (_St.st_size > 0)
+                {
+                _Length = static_cast<std::size_t>(_St.st_size);
+                void * _Map = ::mmap(0, _Length, PROT_READ, MAP_PRIVATE,
+                                     _Fd, 0);
+                if (_Map == MAP_FAILED)
+                        {
+                        _Error = errno;
+                        _Length = 0;
+                        }
+                else
+                        {
+                        // the chunks are read concurrently, not in order
+                        ::madvise(_Map, _Length, MADV_WILLNEED);
+                        _Data = static_cast<const char *>(_Map);
+                        _Mapped = true;
+                        }
+                }
+        ::close(_Fd);
+#else
+        std::FILE * _Fp = std::fopen(_Path, "rb");
+        if (_Fp == 0)
+                {
+                _Error = errno ? errno : ENOENT;
+                return;
+                }
+        std::vector<char> _Buf;
+        char _Block[65536];
+        std::size_t _N;
+        while ((_N = std::fread(_Block, 1, sizeof(_Block), _Fp)) != 0)
+                { _Buf.insert(_Buf.end(), _Block, _Block + _N); }
+        if (std::ferror(_Fp))
+                { _Error = errno ? errno : EIO; }
+        std::fclose(_Fp);
+        if (_Error == 0 && !_Buf.empty())
+                {
+                char * _Copy = new char[_Buf.size()];
+                std::memcpy(_Copy, &_Buf[0], _Buf.size());
+                _Data = _Copy;
+                _Length = _Buf.size();
+                }
+#endif /* def _DEC_HAS_MMAP */
+
+        if (_Error == 0)
+                { _Split(); }
+        }
+
+decimal_file::~decimal_file()
+        {
+        if (_Data == 0)
+                { return; }
+#ifdef _DEC_HAS_MMAP
+        if (_Mapped)
+                {
+                ::munmap(const_cast<char *>(_Data), _Length);
+                return;
+                }
+#endif /* def _DEC_HAS_MMAP */
+        delete [] _Data;
+        }
+
+// arguments of _CountChunk
+struct _SplitArgs {
+        const char *        _Data;
+        const std::size_t * _ChunkBeg;
+        std::size_t *       _Lines;
+};
+
+static void _CountChunk(void * _Arg, std::size_t _I)
+        {
+        _SplitArgs * _A = static_cast<_SplitArgs *>(_Arg);
+        _A->_Lines[_I] = _CountLines(_A->_Data + _A->_ChunkBeg[_I],
+                                     _A->_Data + _A->_ChunkBeg[_I + 1]);
+        }
+
+void decimal_file::_Split()
+        {
+        const unsigned _Threads = _ThreadCount(0);
+        std::size_t _Chunks = _Threads * _ChunksPerThread;
+        if (_Chunks > _Length / _MinChunkBytes)
+                { _Chunks = _Length / _MinChunkBytes; }
+        if (_Chunks == 0)
+                { _Chunks = 1; }
+
+        // move each boundary forward to the start of a line
+        _ChunkBeg.push_back(0);
+        for (std::size_t _I = 1; _I < _Chunks; ++_I)
+                {
+                std::size_t _Pos = _Length / _Chunks * _I;
+                if (_Pos <= _ChunkBeg.back())
+                        { continue; }
+                const void * _Nl = std::memchr(_Data + _Pos - 1, '\n',
+                                               _Length - _Pos + 1);
+                if (_Nl == 0)
+                        { break; }
+                _Pos = static_cast<const char *>(_Nl) - _Data + 1;
+                if (_Pos < _Length && _Pos > _ChunkBeg.back())
+                        { _ChunkBeg.push_back(_Pos); }
+                }
+        _ChunkBeg.push_back(_Length);
+
+        const std::size_t _N = _ChunkBeg.size() - 1;
+        std::vector<std::size_t> _Lines(_N);
+        _SplitArgs _A;
+        _A._Data = _Data;
+        _A._ChunkBeg = &_ChunkBeg[0];
+        _A._Lines = &_Lines[0];
+        _ParallelFor(_N, _CountChunk, &_A, _Threads);
+
+        _ChunkFirst.resize(_N + 1);
+        _ChunkFirst[0] = 0;
+        for (std::size_t _I = 0; _I != _N; ++_I)
+                { _ChunkFirst[_I + 1] = _ChunkFirst[_I] + _Lines[_I]; }
+        }
+
+// arguments of _LoadChunk
+struct _LoadArgs {
+        const char *        _Data;
+        const std::size_t * _ChunkBeg;
+        const std::size_t * _ChunkFirst;
+        decimal128 *        _Out;
+        std::size_t         _Count;
+        uint32_t *          _Status;
+};
+
+static void _LoadChunk(void * _Arg, std::size_t _I)
+        {
+        typedef _FmtTraits<decimal128> _Tr;
+
+        _LoadArgs * _A = static_cast<_LoadArgs *>(_Arg);
+        std::size_t _Idx = _A->_ChunkFirst[_I];
+        if (_Idx >= _A->_Count)
+                { return; }
+
+        _Tr::_Context _Ctxt(false);
+        const char * _Beg = _A->_Data + _A->_ChunkBeg[_I];
+        const char * const _End = _A->_Data + _A->_ChunkBeg[_I + 1];
+        for (; _Beg != _End && _Idx != _A->_Count; ++_Idx)
+                {
+                const char * _Eol = static_cast<const char *>(
+                                std::memchr(_Beg, '\n', _End - _Beg));
+                const char * const _Next = _Eol ? _Eol + 1 : _End;
+                if (_Eol == 0)
+                        { _Eol = _End; }
+
+                while (_Beg != _Eol && _IsBlank(*_Beg))
+                        { ++_Beg; }
+                while (_Eol != _Beg && _IsBlank(_Eol[-1]))
+                        { --_Eol; }
+
+                decimal128 & _V = _A->_Out[_Idx];
+                const from_chars_result _R =
+                        _FromChars<_Tr>(_Beg, _Eol, _V, _Ctxt);
+                if (_R.ec == EINVAL || _R.ptr != _Eol)
+                        {
+                        _V = decimal128::_GetNAN();
+                        _Ctxt.status |= DEC_Conversion_syntax;
+                        }
+                _Beg = _Next;
+                }
+        _A->_Status[_I] = _Ctxt.status;
+        }
+
+load_result decimal_file::load(decimal128 * _Out,
+                               std::size_t _Count,
+                               unsigned _Threads) const
+        {
+        load_result _Ret;
+        _Ret.count = 0;
+        _Ret.status = 0;
+        _Ret.ec = _Error;
+        if (_Error != 0 || _ChunkFirst.empty())
+                { return _Ret; }
+
+        const std::size_t _N = _ChunkBeg.size() - 1;
+        std::vector<uint32_t> _Status(_N, 0);
+        _LoadArgs _A;
+        _A._Data = _Data;
+        _A._ChunkBeg = &_ChunkBeg[0];
+        _A._ChunkFirst = &_ChunkFirst[0];
+        _A._Out = _Out;
+        _A._Count = _Count;
+        _A._Status = &_Status[0];
+        _ParallelFor(_N, _LoadChunk, &_A, _Threads);
+
+        for (std::size_t _I = 0; _I != _N; ++_I)
+                { _Ret.status |= _Status[_I]; }
+        _Ret.count = _Count < size() ? _Count : size();
+        return _Ret;
+        }
+
+load_result load_decimal_file(const char * _Path,
+                              std::vector<decimal128> & _Out,
+                              unsigned _Threads)
+        {
+        const decimal_file _File(_Path);
+        _Out.resize(_File.size());
+        return _File.load(_Out.empty() ? 0 : &_Out[0], _Out.size(),
+                          _Threads);
+        }
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,1747 @@
+/* ------------------------------------------------------------------ */
+/* decMath.cpp source file                                            */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <cmath>
+
+#include "impl/decMath.h"
+#include "impl/decNative.h"
+
+namespace std {
+namespace decimal {
+
+static const uint64_t _Pow10[20] = {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+        10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+        100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL, 1000000000000000000ULL,
+        10000000000000000000ULL
+};
+
+// the number of digits of _C, which is not zero
+static int _CountDigits(uint64_t _C)
+        {
+        int _N = 1;
+        while (_N != 20 && _C >= _Pow10[_N])
+                { ++_N; }
+        return _N;
+        }
+
+#if defined(_DEC_HAS_INT128)
+
+// Fixed point numbers with _FracBits fraction bits.  The arguments and
+// results handled here stay below 2^11 in magnitude.
+typedef _NativeInt128  _Fixed;
+typedef _NativeUint128 _UFixed;
+
+static const int    _FracBits = 116;
+static const _Fixed _One = static_cast<_Fixed>(1) << _FracBits;
+
+#define _DEC_FIXED(_Hi, _Lo) \
+        (static_cast<_Fixed>(_Hi) << 64 | static_cast<_Fixed>(_Lo))
+
+// A multiplier for 10^-n: c 10^-n as a fixed point number is the
+// product of c and the 128-bit _Hi:_Lo, shifted right by _Shift bits.
+struct _Scale {
+        uint64_t _Hi;
+        uint64_t _Lo;
+        int      _Shift;
+};
+
+// ln(10), 1/ln(10) and ln(2)
+static const _Fixed _Ln10 =
+        _DEC_FIXED(0x0024d763776aaa2bULL, 0x05ba95b58ae0b4c3ULL);
+static const _Fixed _InvLn10 =
+        _DEC_FIXED(0x0006f2dec549b943ULL, 0x8ca9aadd557d699fULL);
+static const _Fixed _Ln2 =
+        _DEC_FIXED(0x000b17217f7d1cf7ULL, 0x9abc9e3b39803f2fULL);
+
+// exp(j/16), j = 0 .. 36
+static const _Fixed _ExpTable1[37] = {
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0011082b577d34edULL, 0x7d5b1a019e225c9bULL),
+         _DEC_FIXED(0x0012216045b6f5ccULL, 0xf9ced688384e06b9ULL),
+         _DEC_FIXED(0x00134cb8170b5835ULL, 0x2d4e0c48cb7c6649ULL),
+         _DEC_FIXED(0x00148b5e3c3e8186ULL, 0x6767bc3b69baabe5ULL),
+         _DEC_FIXED(0x0015de9176045ff5ULL, 0x3b51324653175440ULL),
+         _DEC_FIXED(0x001747a513dbef6aULL, 0x623478b659b09240ULL),
+         _DEC_FIXED(0x0018c802477b000fULL, 0xdc24db40ed853111ULL),
+         _DEC_FIXED(0x001a61298e1e069bULL, 0xc972dfefab6df340ULL),
+         _DEC_FIXED(0x001c14b431256446ULL, 0x4432aa513ba42200ULL),
+         _DEC_FIXED(0x001de455df80e3c0ULL, 0x5ca897b072f6daa6ULL),
+         _DEC_FIXED(0x001fd1de6182f8c8ULL, 0x9d2c3b6d08c65972ULL),
+         _DEC_FIXED(0x0021df3b68cfb9efULL, 0x7a986addc7dcee22ULL),
+         _DEC_FIXED(0x00240e7a7e37aa2fULL, 0xff223a7861b5865cULL),
+         _DEC_FIXED(0x002661cb0f6c564fULL, 0x38443feaf672143aULL),
+         _DEC_FIXED(0x0028db809e9ca670ULL, 0x4a25bfd953414f0fULL),
+         _DEC_FIXED(0x002b7e151628aed2ULL, 0xa6abf7158809cf4fULL),
+         _DEC_FIXED(0x002e4c2b42c0e531ULL, 0x1f75a0a1ae923d4cULL),
+         _DEC_FIXED(0x00314891766b0ed0ULL, 0xe3e661d5353de3b7ULL),
+         _DEC_FIXED(0x0034764457102470ULL, 0xc378267b1384ad9cULL),
+         _DEC_FIXED(0x0037d871db61f5dfULL, 0xcaea9e08a299ccb2ULL),
+         _DEC_FIXED(0x003b727c7915b29eULL, 0xc086e39b73b1905dULL),
+         _DEC_FIXED(0x003f47fe87a1d5f1ULL, 0x9a0d2dac7ad2963dULL),
+         _DEC_FIXED(0x00435ccddae27c89ULL, 0xe47dca21d8366eeaULL),
+         _DEC_FIXED(0x0047b4ff993f1505ULL, 0x5f6e4658d43e9de4ULL),
+         _DEC_FIXED(0x004c54ec5127e2ccULL, 0x7e5ce59dd8c68354ULL),
+         _DEC_FIXED(0x00514134520127f6ULL, 0x60ee92dc97a97881ULL),
+         _DEC_FIXED(0x00567ec44cd53e1dULL, 0x8103fdd848ed5efdULL),
+         _DEC_FIXED(0x005c12da416eb2faULL, 0xb7e8026f762a8663ULL),
+         _DEC_FIXED(0x0062030abcc7ebfeULL, 0x38d76963c6f0d9c1ULL),
+         _DEC_FIXED(0x006855466e0f306cULL, 0x77840907e7a69b25ULL),
+         _DEC_FIXED(0x006f0fe017d49522ULL, 0xbb3eb958eb5fea9cULL),
+         _DEC_FIXED(0x00763992e35376b7ULL, 0x30ce8ee881ada2afULL),
+         _DEC_FIXED(0x007dd9891c2b5263ULL, 0xe4c74f8d3c24507fULL),
+         _DEC_FIXED(0x0085f7635b44463fULL, 0x17efa0e17757f51aULL),
+         _DEC_FIXED(0x008e9b40280ab62eULL, 0x9ef755b858e49ca3ULL),
+         _DEC_FIXED(0x0097cdc417a3f405ULL, 0xa65732b338b50f5aULL)
+};
+
+// exp(j/1024), j = 0 .. 63
+static const _Fixed _ExpTable2[64] = {
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x00100400800aab55ULL, 0x5dde38e6ce86e927ULL),
+         _DEC_FIXED(0x0010080200556001ULL, 0x1127d41d5bd72f4dULL),
+         _DEC_FIXED(0x00100c0481203608ULL, 0x1a9ce894e3dfc9a7ULL),
+         _DEC_FIXED(0x0010100802ab5577ULL, 0x7d28a2a42d26aa9fULL),
+         _DEC_FIXED(0x0010140c8536f668ULL, 0x4062198ee751446dULL),
+         _DEC_FIXED(0x0010181209036103ULL, 0x740de5591eb19606ULL),
+         _DEC_FIXED(0x00101c188e50ed86ULL, 0x34a0b51ede8a979dULL),
+         _DEC_FIXED(0x0010202015600445ULL, 0xb0c326382bc7368aULL),
+         _DEC_FIXED(0x001024289e711db3ULL, 0x2fd71c8195ebeb17ULL),
+         _DEC_FIXED(0x0010283229c4c260ULL, 0x197edc31b41d51daULL),
+         _DEC_FIXED(0x00102c3cb79b8b01ULL, 0xfe2625b4002f1640ULL),
+         _DEC_FIXED(0x0010304848362076ULL, 0xa08d9411a1cee76dULL),
+         _DEC_FIXED(0x00103454dbd53bc8ULL, 0x00587e80e0082524ULL),
+         _DEC_FIXED(0x0010386272b9a630ULL, 0x659d9dc4178f7236ULL),
+         _DEC_FIXED(0x00103c710d24391eULL, 0x6d7ab61140826801ULL),
+         _DEC_FIXED(0x00104080ab55de39ULL, 0x17ab864b3e9044e7ULL),
+         _DEC_FIXED(0x001044914d8f8f63ULL, 0xd5243d666ad5a21bULL),
+         _DEC_FIXED(0x001048a2f41256c2ULL, 0x97afb6e1ff180627ULL),
+         _DEC_FIXED(0x00104cb59f1f4ebdULL, 0xe291bf50467f8d70ULL),
+         _DEC_FIXED(0x001050c94ef7a206ULL, 0xdc2da1f7b86de3f9ULL),
+         _DEC_FIXED(0x001054de03dc8b9bULL, 0x60b140a766a36fe3ULL),
+         _DEC_FIXED(0x001058f3be0f56caULL, 0x15c4f6e97086d737ULL),
+         _DEC_FIXED(0x00105d0a7dd15f36ULL, 0x7f4089ce7a190177ULL),
+         _DEC_FIXED(0x00106122436410ddULL, 0x14e5659d75e95b77ULL),
+         _DEC_FIXED(0x0010653b0f08e817ULL, 0x591e6ac3663c7f00ULL),
+         _DEC_FIXED(0x00106954e101719fULL, 0xf0c58b6f128b74f4ULL),
+         _DEC_FIXED(0x00106d6fb98f4a96ULL, 0xbbef7b550b8c9dbaULL),
+         _DEC_FIXED(0x0010718b98f42084ULL, 0xefbdb328b919e691ULL),
+         _DEC_FIXED(0x001075a87f71b161ULL, 0x31370967928358c5ULL),
+         _DEC_FIXED(0x001079c66d49cb93ULL, 0xb12722240b324860ULL),
+         _DEC_FIXED(0x00107de562be4dfaULL, 0x4904f78e2af17917ULL),
+         _DEC_FIXED(0x00108205601127ecULL, 0x98e0bd083aba80c9ULL),
+         _DEC_FIXED(0x0010862665845940ULL, 0x26595ea664918651ULL),
+         _DEC_FIXED(0x00108a487359f24cULL, 0x7c99df089ebf4044ULL),
+         _DEC_FIXED(0x00108e6b89d413efULL, 0x4d5ed58eb89ed249ULL),
+         _DEC_FIXED(0x0010928fa934ef90ULL, 0x93044ef6e13adf7dULL),
+         _DEC_FIXED(0x001096b4d1bec726ULL, 0xb39c5287861be62cULL),
+         _DEC_FIXED(0x00109adb03b3ed3aULL, 0xa50e4df5f2f2c4bbULL),
+         _DEC_FIXED(0x00109f023f56c4ecULL, 0x123faa4ba9362992ULL),
+         _DEC_FIXED(0x0010a32a84e9c1f5ULL, 0x8145cc1cf959b1b1ULL),
+         _DEC_FIXED(0x0010a753d4af68b0ULL, 0x7aa1c173fdfaa38cULL),
+         _DEC_FIXED(0x0010ab7e2eea4e19ULL, 0xb185dfe3b439904cULL),
+         _DEC_FIXED(0x0010afa993dd17d5ULL, 0x2d2595478b7abd5dULL),
+         _DEC_FIXED(0x0010b3d603ca7c32ULL, 0x730fadc469f215fdULL),
+         _DEC_FIXED(0x0010b8037ef54230ULL, 0xb29351b0cab391e1ULL),
+         _DEC_FIXED(0x0010bc3205a04182ULL, 0xf12ffe1a457f85f1ULL),
+         _DEC_FIXED(0x0010c061980e6294ULL, 0x3810baaf802c40eaULL),
+         _DEC_FIXED(0x0010c49236829e8bULL, 0xc292cfe63d64b296ULL),
+         _DEC_FIXED(0x0010c8c3e13fff51ULL, 0x2dd84045f477b464ULL),
+         _DEC_FIXED(0x0010ccf698899f90ULL, 0xa96647d01a25e925ULL),
+         _DEC_FIXED(0x0010d12a5ca2aabfULL, 0x28d0249002be1ae9ULL),
+         _DEC_FIXED(0x0010d55f2dce5d1eULL, 0x966e6b6d0a6a8e25ULL),
+         _DEC_FIXED(0x0010d9950c5003c2ULL, 0x07232c6a7955fbcdULL),
+         _DEC_FIXED(0x0010ddcbf86afc91ULL, 0xef2b29916645d671ULL),
+         _DEC_FIXED(0x0010e203f262b650ULL, 0x57fc63d1ab723484ULL),
+         _DEC_FIXED(0x0010e63cfa7ab09dULL, 0x17324137d6c341c2ULL),
+         _DEC_FIXED(0x0010ea7710f67bfaULL, 0x06878fe6d8317fa2ULL),
+         _DEC_FIXED(0x0010eeb23619b9cfULL, 0x3cdea9550ed26f51ULL),
+         _DEC_FIXED(0x0010f2ee6a281c6fULL, 0x4857f95d371f8bfeULL),
+         _DEC_FIXED(0x0010f72bad65671bULL, 0x69772cc4a342d0e0ULL),
+         _DEC_FIXED(0x0010fb6a00156e07ULL, 0xcf574ae910ab71acULL),
+         _DEC_FIXED(0x0010ffa9627c165fULL, 0xd4edfe595cdffc67ULL),
+         _DEC_FIXED(0x001103e9d4dd564aULL, 0x3f5e502d4e71e035ULL)
+};
+
+// 1/i!, i = 0 .. 8
+static const _Fixed _ExpSeries[9] = {
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0008000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0002aaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL),
+         _DEC_FIXED(0x0000aaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL),
+         _DEC_FIXED(0x0000222222222222ULL, 0x2222222222222222ULL),
+         _DEC_FIXED(0x000005b05b05b05bULL, 0x05b05b05b05b05b0ULL),
+         _DEC_FIXED(0x000000d00d00d00dULL, 0x00d00d00d00d00d0ULL),
+         _DEC_FIXED(0x0000001a01a01a01ULL, 0xa01a01a01a01a01aULL)
+};
+
+// 32/j, j = 24 .. 48
+static const _Fixed _LogRecip1[25] = {
+         _DEC_FIXED(0x0015555555555555ULL, 0x5555555555555555ULL),
+         _DEC_FIXED(0x00147ae147ae147aULL, 0xe147ae147ae147aeULL),
+         _DEC_FIXED(0x0013b13b13b13b13ULL, 0xb13b13b13b13b13bULL),
+         _DEC_FIXED(0x0012f684bda12f68ULL, 0x4bda12f684bda12fULL),
+         _DEC_FIXED(0x0012492492492492ULL, 0x4924924924924925ULL),
+         _DEC_FIXED(0x0011a7b9611a7b96ULL, 0x11a7b9611a7b9612ULL),
+         _DEC_FIXED(0x0011111111111111ULL, 0x1111111111111111ULL),
+         _DEC_FIXED(0x0010842108421084ULL, 0x2108421084210842ULL),
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x000f83e0f83e0f83ULL, 0xe0f83e0f83e0f83eULL),
+         _DEC_FIXED(0x000f0f0f0f0f0f0fULL, 0x0f0f0f0f0f0f0f0fULL),
+         _DEC_FIXED(0x000ea0ea0ea0ea0eULL, 0xa0ea0ea0ea0ea0eaULL),
+         _DEC_FIXED(0x000e38e38e38e38eULL, 0x38e38e38e38e38e4ULL),
+         _DEC_FIXED(0x000dd67c8a60dd67ULL, 0xc8a60dd67c8a60ddULL),
+         _DEC_FIXED(0x000d79435e50d794ULL, 0x35e50d79435e50d8ULL),
+         _DEC_FIXED(0x000d20d20d20d20dULL, 0x20d20d20d20d20d2ULL),
+         _DEC_FIXED(0x000cccccccccccccULL, 0xcccccccccccccccdULL),
+         _DEC_FIXED(0x000c7ce0c7ce0c7cULL, 0xe0c7ce0c7ce0c7ceULL),
+         _DEC_FIXED(0x000c30c30c30c30cULL, 0x30c30c30c30c30c3ULL),
+         _DEC_FIXED(0x000be82fa0be82faULL, 0x0be82fa0be82fa0cULL),
+         _DEC_FIXED(0x000ba2e8ba2e8ba2ULL, 0xe8ba2e8ba2e8ba2fULL),
+         _DEC_FIXED(0x000b60b60b60b60bULL, 0x60b60b60b60b60b6ULL),
+         _DEC_FIXED(0x000b21642c8590b2ULL, 0x1642c8590b21642dULL),
+         _DEC_FIXED(0x000ae4c415c9882bULL, 0x9310572620ae4c41ULL),
+         _DEC_FIXED(0x000aaaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL)
+};
+
+// -ln(_LogRecip1[j]), as stored
+static const _Fixed _LogTable1[25] = {
+        -_DEC_FIXED(0x00049a58844d36e4ULL, 0x9e0efadd9db02aa7ULL),
+        -_DEC_FIXED(0x0003f3238d96766fULL, 0x2fb328337cc050c7ULL),
+        -_DEC_FIXED(0x0003527da7915b3cULL, 0x6de57d4ef4b901baULL),
+        -_DEC_FIXED(0x0002b7e80d6a87b6ULL, 0x3f70525d9f9040c5ULL),
+        -_DEC_FIXED(0x000222f1d044fc8fULL, 0x7bc671683f8e5bd1ULL),
+        -_DEC_FIXED(0x00019335e5d59498ULL, 0x8ae1d5ea3eccd251ULL),
+        -_DEC_FIXED(0x000108598b59e3a0ULL, 0x688a3fd9bf503373ULL),
+        -_DEC_FIXED(0x0000820aec4f3a22ULL, 0x2380b9e3aea6c445ULL),
+         _DEC_FIXED(0x0000000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x00007e0a6c39e0ccULL, 0x0133e3f04f1ef22aULL),
+         _DEC_FIXED(0x0000f85186008b15ULL, 0x330be64b8b775998ULL),
+         _DEC_FIXED(0x00016f0d28ae56b4ULL, 0xb9be499b9ed19b64ULL),
+         _DEC_FIXED(0x0001e27076e2af2eULL, 0x5e9ea87ffe1fe9e1ULL),
+         _DEC_FIXED(0x000252aa5f03fea4ULL, 0x6980bb8e203edf4eULL),
+         _DEC_FIXED(0x0002bfe60e14f27aULL, 0x790e7c4140e42477ULL),
+         _DEC_FIXED(0x00032a4b539e8ad6ULL, 0x8ec8260ea71712cfULL),
+         _DEC_FIXED(0x000391fef8f35344ULL, 0x3584bb03de5ff734ULL),
+         _DEC_FIXED(0x0003f7230dabc7c5ULL, 0x51aaa8cd86f29a59ULL),
+         _DEC_FIXED(0x000459d72aeae983ULL, 0x80e731f55c41b8b8ULL),
+         _DEC_FIXED(0x0004ba38aeb8474cULL, 0x270b3246a14206cfULL),
+         _DEC_FIXED(0x00051862f08717b0ULL, 0x9f42decdeccf1cd0ULL),
+         _DEC_FIXED(0x0005746f6fd60272ULL, 0x94236383dc7fe116ULL),
+         _DEC_FIXED(0x0005ce75fdaef401ULL, 0xa7389314feb4fbdeULL),
+         _DEC_FIXED(0x0006268ce1b05096ULL, 0xad69c620440f055cULL),
+         _DEC_FIXED(0x00067cc8fb2fe612ULL, 0xfcada35d9bd01488ULL)
+};
+
+// 1/(1 + j/1024), j = -22 .. 22
+static const _Fixed _LogRecip2[45] = {
+         _DEC_FIXED(0x001059eea0727586ULL, 0x632136acb5e87eb9ULL),
+         _DEC_FIXED(0x001055c23bb98e2aULL, 0x5e6fcae948bde4f2ULL),
+         _DEC_FIXED(0x00105197f7d73404ULL, 0x1465fdf5cd010519ULL),
+         _DEC_FIXED(0x00104d6fd32b0c7bULL, 0x499dacf58e645cb8ULL),
+         _DEC_FIXED(0x00104949cc1664c5ULL, 0x789eca8f85da5685ULL),
+         _DEC_FIXED(0x00104525e0fc2fcbULL, 0x1f44e4cc64abda60ULL),
+         _DEC_FIXED(0x0010410410410410ULL, 0x4104104104104104ULL),
+         _DEC_FIXED(0x00103ce4584b19a0ULL, 0x185b568470a67025ULL),
+         _DEC_FIXED(0x001038c6b78247fbULL, 0xf1ce521f6e01038cULL),
+         _DEC_FIXED(0x001034ab2c50040dULL, 0x2acb1401034ab2c5ULL),
+         _DEC_FIXED(0x00103091b51f5e1aULL, 0x4eecc652f8eac041ULL),
+         _DEC_FIXED(0x00102c7a505cffbfULL, 0x4e16be8c0102c7a5ULL),
+         _DEC_FIXED(0x00102864fc7729e8ULL, 0xc5eed514b3c16379ULL),
+         _DEC_FIXED(0x00102451b7ddb2d2ULL, 0x5948e40102451b7eULL),
+         _DEC_FIXED(0x0010204081020408ULL, 0x1020408102040810ULL),
+         _DEC_FIXED(0x00101c315657186aULL, 0xbac6dc0101c31565ULL),
+         _DEC_FIXED(0x0010182436517a37ULL, 0x52fc7ab8141e2d44ULL),
+         _DEC_FIXED(0x001014191f674111ULL, 0x55ab15db5226b05cULL),
+         _DEC_FIXED(0x0010101010101010ULL, 0x1010101010101010ULL),
+         _DEC_FIXED(0x00100c0906c513ceULL, 0xdb245b44735680e1ULL),
+         _DEC_FIXED(0x0010080402010080ULL, 0x4020100804020101ULL),
+         _DEC_FIXED(0x0010040100401004ULL, 0x0100401004010040ULL),
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x000ffc00ffc00ffcULL, 0x00ffc00ffc00ffc0ULL),
+         _DEC_FIXED(0x000ff803fe00ff80ULL, 0x3fe00ff803fe0100ULL),
+         _DEC_FIXED(0x000ff408f9450c36ULL, 0xd6ded8dd59fc829eULL),
+         _DEC_FIXED(0x000ff00ff00ff00fULL, 0xf00ff00ff00ff010ULL),
+         _DEC_FIXED(0x000fec18e0e6df68ULL, 0xbd13a76eb59cfbc5ULL),
+         _DEC_FIXED(0x000fe823ca508735ULL, 0x3037ac7d4419d93aULL),
+         _DEC_FIXED(0x000fe430aad50b2cULL, 0x72381dcbdb404f75ULL),
+         _DEC_FIXED(0x000fe03f80fe03f8ULL, 0x0fe03f80fe03f810ULL),
+         _DEC_FIXED(0x000fdc504b567d65ULL, 0xdad3a3cf6d4a1947ULL),
+         _DEC_FIXED(0x000fd863086af49cULL, 0x78d1f3202f892919ULL),
+         _DEC_FIXED(0x000fd477b6c95652ULL, 0x9cd0c1eaba7f2261ULL),
+         _DEC_FIXED(0x000fd08e5500fd08ULL, 0xe5500fd08e5500fdULL),
+         _DEC_FIXED(0x000fcca6e1a2af46ULL, 0x5b5724c874854ec0ULL),
+         _DEC_FIXED(0x000fc8c15b409dd7ULL, 0x8d90862a6b87a53eULL),
+         _DEC_FIXED(0x000fc4ddc06e6210ULL, 0x4304ae71d520c51dULL),
+         _DEC_FIXED(0x000fc0fc0fc0fc0fULL, 0xc0fc0fc0fc0fc0fcULL),
+         _DEC_FIXED(0x000fbd1c47ced107ULL, 0x9f99b2c82d3fb14eULL),
+         _DEC_FIXED(0x000fb93e672fa985ULL, 0x28c879dba39fb162ULL),
+         _DEC_FIXED(0x000fb5626c7cafbdULL, 0x3d1db2ee151bbc42ULL),
+         _DEC_FIXED(0x000fb18856506ddaULL, 0xba5c3300fb188565ULL),
+         _DEC_FIXED(0x000fadb02346cc4fULL, 0x5f4bb2966a51d26fULL),
+         _DEC_FIXED(0x000fa9d9d1fd1027ULL, 0x28a08cf8a861e591ULL)
+};
+
+// -ln(_LogRecip2[j]), as stored
+static const _Fixed _LogTable2[45] = {
+        -_DEC_FIXED(0x000058f585e1a42fULL, 0x57e712b2ca836369ULL),
+        -_DEC_FIXED(0x000054df8fd17cd5ULL, 0x92ce96bf9299595fULL),
+        -_DEC_FIXED(0x000050caa4966033ULL, 0x0273250c6ffbe6daULL),
+        -_DEC_FIXED(0x00004cb6c3a84cb8ULL, 0x86589844afdde0b1ULL),
+        -_DEC_FIXED(0x000048a3ec7fa8b8ULL, 0x9f19424c8ff1ec96ULL),
+        -_DEC_FIXED(0x000044921e9541fdULL, 0xbe5fed4b39281ad5ULL),
+        -_DEC_FIXED(0x0000408159624d61ULL, 0x1d27c8e8416e71efULL),
+        -_DEC_FIXED(0x00003c719c606662ULL, 0x1775c25d7e60f271ULL),
+        -_DEC_FIXED(0x00003862e7098ebeULL, 0x0cc03104602610feULL),
+        -_DEC_FIXED(0x0000345538d82e08ULL, 0xc43b292cb8dee40bULL),
+        -_DEC_FIXED(0x0000304891471145ULL, 0x54412c584dfc2680ULL),
+        -_DEC_FIXED(0x00002c3cefd16a7fULL, 0x8c11507150cb4034ULL),
+        -_DEC_FIXED(0x0000283253f2d065ULL, 0xdf1d57404da1eeebULL),
+        -_DEC_FIXED(0x00002428bd273de3ULL, 0xd1238c4e9ffb36edULL),
+        -_DEC_FIXED(0x000020202aeb11bcULL, 0xe251998b505f3b40ULL),
+        -_DEC_FIXED(0x00001c189cbb0e27ULL, 0xfaaeda77a9fb3143ULL),
+        -_DEC_FIXED(0x000018121214586bULL, 0x540e0a5cfc9bbd0fULL),
+        -_DEC_FIXED(0x0000140c8a747878ULL, 0xe1c77c1c000624bcULL),
+        -_DEC_FIXED(0x000010080559588bULL, 0x357e598e33d8d9dbULL),
+        -_DEC_FIXED(0x00000c04824144c2ULL, 0xe034b53860627f6dULL),
+        -_DEC_FIXED(0x0000080200aaeac4ULL, 0x4ef38338f77605ffULL),
+        -_DEC_FIXED(0x0000040080155956ULL, 0x224cd5f35f87d21bULL),
+         _DEC_FIXED(0x0000000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x000003ff80155156ULL, 0x21f7809a0a324992ULL),
+         _DEC_FIXED(0x000007fe00aa6ac4ULL, 0x399e29e3a153e3b1ULL),
+         _DEC_FIXED(0x00000bfb823ebcc1ULL, 0xed344eb432409d00ULL),
+         _DEC_FIXED(0x00000ff805515885ULL, 0xe0250435ab4da6a6ULL),
+         _DEC_FIXED(0x000013f38a60f064ULL, 0x895a4f24dd250118ULL),
+         _DEC_FIXED(0x000017ee11ebd82eULL, 0x93a785a4740e89c0ULL),
+         _DEC_FIXED(0x00001be79c70058eULL, 0xc8f9a6c04043f527ULL),
+         _DEC_FIXED(0x00001fe02a6b1067ULL, 0x88fc37690391dc28ULL),
+         _DEC_FIXED(0x000023d7bc5a332fULL, 0xcbe005b91e4d137fULL),
+         _DEC_FIXED(0x000027ce52ba4b4fULL, 0xb1f006b2f75de2fdULL),
+         _DEC_FIXED(0x00002bc3ee07d97cULL, 0xa09f585da1b49dc5ULL),
+         _DEC_FIXED(0x00002fb88ebf0214ULL, 0xedba4a25e0b0837dULL),
+         _DEC_FIXED(0x000033ac355b8d7bULL, 0x196327b4256d35cbULL),
+         _DEC_FIXED(0x0000379ee258e870ULL, 0x97825ef65dc2d996ULL),
+         _DEC_FIXED(0x00003b9096322470ULL, 0x295078e96cc13ef9ULL),
+         _DEC_FIXED(0x00003f815161f807ULL, 0xc79f3db4e9a6f57bULL),
+         _DEC_FIXED(0x000043711462bf32ULL, 0x1e863fe760201885ULL),
+         _DEC_FIXED(0x0000475fdfae7bafULL, 0x9b15f00ce1692038ULL),
+         _DEC_FIXED(0x00004b4db3bed55fULL, 0x0bb341706c37cc22ULL),
+         _DEC_FIXED(0x00004f3a910d1a95ULL, 0xd3bcd295bf531791ULL),
+         _DEC_FIXED(0x0000532678124077ULL, 0xb31977d7d292f94dULL),
+         _DEC_FIXED(0x000057116946e34eULL, 0x224ef493c13de4c3ULL)
+};
+
+// (-1)^i/(i+1), i = 0 .. 9
+static const _Fixed _LogSeries[10] = {
+         _DEC_FIXED(0x0010000000000000ULL, 0x0000000000000000ULL),
+        -_DEC_FIXED(0x0008000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0005555555555555ULL, 0x5555555555555555ULL),
+        -_DEC_FIXED(0x0004000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0003333333333333ULL, 0x3333333333333333ULL),
+        -_DEC_FIXED(0x0002aaaaaaaaaaaaULL, 0xaaaaaaaaaaaaaaabULL),
+         _DEC_FIXED(0x0002492492492492ULL, 0x4924924924924925ULL),
+        -_DEC_FIXED(0x0002000000000000ULL, 0x0000000000000000ULL),
+         _DEC_FIXED(0x0001c71c71c71c71ULL, 0xc71c71c71c71c71cULL),
+        -_DEC_FIXED(0x0001999999999999ULL, 0x999999999999999aULL)
+};
+
+// multipliers for 10^-n, n = 0 .. 56
+static const _Scale _Pow10Neg[57] = {
+        { 0x8000000000000000ULL, 0x0000000000000000ULL,  11 },
+        { 0xccccccccccccccccULL, 0xcccccccccccccccdULL,  15 },
+        { 0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL,  18 },
+        { 0x83126e978d4fdf3bULL, 0x645a1cac083126e9ULL,  21 },
+        { 0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL,  25 },
+        { 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,  28 },
+        { 0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL,  31 },
+        { 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,  35 },
+        { 0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3dULL,  38 },
+        { 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,  41 },
+        { 0xdbe6fecebdedd5beULL, 0xb573440e5a884d1bULL,  45 },
+        { 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,  48 },
+        { 0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL,  51 },
+        { 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,  55 },
+        { 0xb424dc35095cd80fULL, 0x538484c19ef38c94ULL,  58 },
+        { 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a10ULL,  61 },
+        { 0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL,  65 },
+        { 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,  68 },
+        { 0x9392ee8e921d5d07ULL, 0x3aff322e62439fcfULL,  71 },
+        { 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e5ULL,  75 },
+        { 0xbce5086492111aeaULL, 0x88f4bb1ca6bcf584ULL,  78 },
+        { 0x971da05074da7beeULL, 0xd3f6fc16ebca5e03ULL,  81 },
+        { 0xf1c90080baf72cb1ULL, 0x5324c68b12dd6338ULL,  85 },
+        { 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,  88 },
+        { 0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL,  91 },
+        { 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,  95 },
+        { 0xc612062576589ddaULL, 0x95364afe032a819dULL,  98 },
+        { 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL, 101 },
+        { 0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 105 },
+        { 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL, 108 },
+        { 0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 111 },
+        { 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL, 114 },
+        { 0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 118 },
+        { 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL, 121 },
+        { 0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113fULL, 124 },
+        { 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL, 128 },
+        { 0xaa242499697392d2ULL, 0xdde50bd1d5d0b9eaULL, 131 },
+        { 0x881cea14545c7575ULL, 0x7e50d64177da2e55ULL, 134 },
+        { 0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 138 },
+        { 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081bULL, 141 },
+        { 0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 144 },
+        { 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL, 148 },
+        { 0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 151 },
+        { 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb243ULL, 154 },
+        { 0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506bULL, 158 },
+        { 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL, 161 },
+        { 0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 164 },
+        { 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a7ULL, 168 },
+        { 0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 171 },
+        { 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL, 174 },
+        { 0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 178 },
+        { 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL, 181 },
+        { 0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 184 },
+        { 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL, 188 },
+        { 0xc428d05aa4751e4cULL, 0xaa97e14c3c26b887ULL, 191 },
+        { 0x9ced737bb6c4183dULL, 0x55464dd69685606cULL, 194 },
+        { 0xfb158592be068d2eULL, 0xeed6e2f0f0d56713ULL, 198 }
+};
+
+// the least coefficient of d digits, d = 1 .. 16, that is at least
+// sqrt(10) 10^(d-1)
+static const uint64_t _Sqrt10[17] = {
+        0ULL,
+        4ULL,
+        32ULL,
+        317ULL,
+        3163ULL,
+        31623ULL,
+        316228ULL,
+        3162278ULL,
+        31622777ULL,
+        316227767ULL,
+        3162277661ULL,
+        31622776602ULL,
+        316227766017ULL,
+        3162277660169ULL,
+        31622776601684ULL,
+        316227766016838ULL,
+        3162277660168380ULL
+};
+
+// The parameters of each format.  The error bounds are in units of
+// 2^-_FracBits, as powers of two, and cover the truncated series and
+// the rounding of the tables and of every product.
+template <class _Fmt>
+struct _MathFmt;
+
+template <>
+struct _MathFmt<decimal32> {
+        static const int _Digits   = 7;
+        static const int _Emin     = -95;
+        static const int _Emax     = 96;
+        static const int _ExpLimit = 200;       // largest |x| for exp()
+        static const int _ExpTerms = 5;
+        static const int _LogTerms = 4;
+        static const int _ExpErr   = 64;
+        static const int _LogErr   = 61;
+        static const int _Log1Err  = 71;        // log() near one
+};
+
+template <>
+struct _MathFmt<decimal64> {
+        static const int _Digits   = 16;
+        static const int _Emin     = -383;
+        static const int _Emax     = 384;
+        static const int _ExpLimit = 800;
+        static const int _ExpTerms = 9;
+        static const int _LogTerms = 10;
+        static const int _ExpErr   = 16;
+        static const int _LogErr   = 12;
+        static const int _Log1Err  = 14;
+};
+
+// the 192-bit product of _V and _K, as _Hi * 2^128 + _Lo
+static void _Mul192(_UFixed _V, uint64_t _K, _UFixed & _Hi, _UFixed & _Lo)
+        {
+        const _UFixed _P0 =
+                static_cast<_UFixed>(static_cast<uint64_t>(_V)) * _K;
+        const _UFixed _P1 = (_V >> 64) * _K;
+        _Lo = _P0 + (_P1 << 64);
+        _Hi = (_P1 >> 64) + (_Lo < _P0 ? 1 : 0);
+        }
+
+// c 10^-n as a fixed point number, for the multiplier _S of 10^-n
+static _Fixed _MulShift(uint64_t _C, const _Scale & _S)
+        {
+        _UFixed _Hi, _Lo;
+        _Mul192(static_cast<_UFixed>(_S._Hi) << 64 | _S._Lo, _C, _Hi, _Lo);
+        if (_S._Shift >= 128)
+                { return static_cast<_Fixed>(_Hi >> (_S._Shift - 128)); }
+        return static_cast<_Fixed>(_Hi << (128 - _S._Shift) |
+                                   _Lo >> _S._Shift);
+        }
+
+// the product of two fixed point numbers, truncated
+static _Fixed _Mul(_Fixed _L, _Fixed _R)
+        {
+        const _UFixed _UL = _L < 0 ? -_L : _L;
+        const _UFixed _UR = _R < 0 ? -_R : _R;
+        const uint64_t _L0 = static_cast<uint64_t>(_UL);
+        const uint64_t _L1 = static_cast<uint64_t>(_UL >> 64);
+        const uint64_t _R0 = static_cast<uint64_t>(_UR);
+        const uint64_t _R1 = static_cast<uint64_t>(_UR >> 64);
+        const _UFixed _P00 = static_cast<_UFixed>(_L0) * _R0;
+        const _UFixed _P01 = static_cast<_UFixed>(_L0) * _R1;
+        const _UFixed _P10 = static_cast<_UFixed>(_L1) * _R0;
+        const _UFixed _P11 = static_cast<_UFixed>(_L1) * _R1;
+        const _UFixed _Mid = (_P00 >> 64) + static_cast<uint64_t>(_P01) +
+                             static_cast<uint64_t>(_P10);
+        const _UFixed _Hi = _P11 + (_P01 >> 64) + (_P10 >> 64) + (_Mid >> 64);
+        const _UFixed _Lo = _Mid << 64 | static_cast<uint64_t>(_P00);
+        const _Fixed _P = static_cast<_Fixed>(_Hi << (128 - _FracBits) |
+                                              _Lo >> _FracBits);
+        return (_L < 0) != (_R < 0) ? -_P : _P;
+        }
+
+// the polynomial with the _N coefficients _C, at _X
+static _Fixed _Horner(const _Fixed * _C, int _N, _Fixed _X)
+        {
+        _Fixed _Y = _C[_N - 1];
+        for (int _I = _N - 2; _I >= 0; --_I)
+                { _Y = _Mul(_Y, _X) + _C[_I]; }
+        return _Y;
+        }
+
+// Rounds _V * _B * 10^_P, the magnitude of a value of sign _Sign, to a
+// coefficient of _Digits digits in _Mode, adjusting _P until the integer
+// part has that many.  _V may be in error by 2^_ErrShift units; if the
+// result is then too close to halfway between two coefficients, or in
+// the directed modes to a coefficient, to be sure of the rounding,
+// returns false.
+static bool _RoundFixed(_UFixed _V, uint64_t _B, int & _P, int _Digits,
+                        int _ErrShift, rounding _Mode, unsigned _Sign,
+                        uint64_t & _Coeff)
+        {
+        const bool _Near = _Mode == DEC_ROUND_HALF_EVEN ||
+                           _Mode == DEC_ROUND_HALF_UP ||
+                           _Mode == DEC_ROUND_HALF_DOWN;
+        const _UFixed _Half = static_cast<_UFixed>(1) << (_FracBits - 1);
+        const _UFixed _Mask = (_Half << 1) - 1;
+        for (int _Tries = 0; _Tries != 24; ++_Tries)
+                {
+                if (_P < 0 || _P > 19 || _B > ~0ULL / _Pow10[_P])
+                        { return false; }
+                const uint64_t _K = _B * _Pow10[_P];
+                _UFixed _Hi, _Lo;
+                _Mul192(_V, _K, _Hi, _Lo);
+                const _UFixed _I = _Hi << (128 - _FracBits) | _Lo >> _FracBits;
+                if (_I >= _Pow10[_Digits])
+                        {
+                        --_P;
+                        continue;
+                        }
+                if (_I < _Pow10[_Digits - 1])
+                        {
+                        ++_P;
+                        continue;
+                        }
+
+                const _UFixed _F = _Lo & _Mask;
+                if ((static_cast<_UFixed>(_K) >>
+                     (_FracBits - 1 - _ErrShift)) != 0)
+                        { return false; }
+                const _UFixed _Err = static_cast<_UFixed>(_K) << _ErrShift;
+                if (_Near ? (_F > _Half ? _F - _Half : _Half - _F) <= _Err :
+                            _F <= _Err || _Mask - _F < _Err)
+                        { return false; }
+
+                // the fraction is neither zero nor one half, so a first
+                // digit dropped of 4 or 6 stands for it
+                _Coeff = static_cast<uint64_t>(_I);
+                if (_RoundsUp(_Mode, _Sign, static_cast<unsigned>(_Coeff % 10),
+                              _F > _Half ? 6 : 4, true))
+                        { ++_Coeff; }
+                if (_Coeff == _Pow10[_Digits])
+                        {
+                        _Coeff = _Pow10[_Digits - 1];
+                        --_P;
+                        }
+                return true;
+                }
+        return false;
+        }
+
+template <class _Fmt>
+static void _Store(_Fmt & _Res, unsigned _Sign, int _Exp, uint64_t _Coeff)
+        {
+        _Native64 _N;
+        _N._Sign = _Sign;
+        _N._Kind = _NativeFinite;
+        _N._Exp = _Exp;
+        _N._Coeff = _Coeff;
+        _Pack(_Res, _N);
+        }
+
+template <class _Fmt>
+static bool _FastExpFmt(const _Fmt & _X, _Fmt & _Res)
+        {
+        typedef _MathFmt<_Fmt> _M;
+        _Native64 _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _N._Coeff == 0)
+                { return false; }
+
+        // If |x| < 10^-(p+1), exp(x) is within 2 |x| of one: 1.00...0
+        // with a first digit dropped of 0 above it, or 0.99...9 with a
+        // first digit dropped of 9 below it.  decNumber returns one for
+        // such arguments in every rounding mode.
+        if (_N._Exp + _CountDigits(_N._Coeff) < -_M::_Digits)
+                {
+                int _Exp = _N._Sign ? -_M::_Digits : 1 - _M::_Digits;
+                uint64_t _Coeff = _N._Sign ? _Pow10[_M::_Digits] - 1 :
+                                             _Pow10[_M::_Digits - 1];
+                if (_RoundsUp(_ContextDefault(false).round, 0,
+                              static_cast<unsigned>(_Coeff % 10),
+                              _N._Sign ? 9 : 0, true))
+                        { ++_Coeff; }
+                if (_Coeff == _Pow10[_M::_Digits])
+                        {
+                        _Coeff = _Pow10[_M::_Digits - 1];
+                        ++_Exp;
+                        }
+                _Store(_Res, 0, _Exp, _Coeff);
+                return true;
+                }
+
+        // the argument in fixed point, if |x| <= _ExpLimit
+        _Fixed _A;
+        if (_N._Exp >= 0)
+                {
+                if (_N._Exp > 2 ||
+                    _N._Coeff > _M::_ExpLimit / _Pow10[_N._Exp])
+                        { return false; }
+                _A = static_cast<_Fixed>(_N._Coeff * _Pow10[_N._Exp]) <<
+                     _FracBits;
+                }
+        else
+                {
+                const int _Scale = -_N._Exp;
+                if (_Scale < 14 &&
+                    _N._Coeff > _M::_ExpLimit * _Pow10[_Scale])
+                        { return false; }
+                _A = _MulShift(_N._Coeff, _Pow10Neg[_Scale]);
+                }
+        if (_N._Sign)
+                { _A = -_A; }
+
+        // x = k ln(10) + r, with 0 <= r < ln(10)
+        int _K = static_cast<int>(_Mul(_A, _InvLn10) >> _FracBits);
+        _Fixed _R = _A - _K * _Ln10;
+        while (_R < 0)
+                {
+                _R += _Ln10;
+                --_K;
+                }
+        while (_R >= _Ln10)
+                {
+                _R -= _Ln10;
+                ++_K;
+                }
+
+        // exp(r) = exp(j1/16) exp(j2/1024) exp(s), with 0 <= s < 2^-10
+        const int _J1 = static_cast<int>(_R >> (_FracBits - 4));
+        _R -= static_cast<_Fixed>(_J1) << (_FracBits - 4);
+        const int _J2 = static_cast<int>(_R >> (_FracBits - 10));
+        _R -= static_cast<_Fixed>(_J2) << (_FracBits - 10);
+        const _Fixed _E = _Mul(_Mul(_ExpTable1[_J1], _ExpTable2[_J2]),
+                               _Horner(_ExpSeries, _M::_ExpTerms, _R));
+
+        int _P = _M::_Digits - 1;
+        uint64_t _Coeff;
+        if (!_RoundFixed(_E, 1, _P, _M::_Digits, _M::_ExpErr,
+                         _ContextDefault(false).round, 0, _Coeff))
+                { return false; }
+        _Store(_Res, 0, _K - _P, _Coeff);
+        return true;
+        }
+
+// The logarithm of x = c 10^-n near one.  With x = 1 + t, log(1 + t) is
+// t q(t), and t = (c - 10^n) 10^-n is exact in decimal, so only q(t)
+// is rounded and the result keeps its full relative precision.
+template <class _Fmt>
+static bool _LogNearOne(uint64_t _C, int _Scale, bool _Base10, _Fmt & _Res)
+        {
+        typedef _MathFmt<_Fmt> _M;
+        const unsigned _Sign = _C < _Pow10[_Scale] ? 1 : 0;
+        const uint64_t _D = _Sign ? _Pow10[_Scale] - _C : _C - _Pow10[_Scale];
+        if (_D == 0)
+                { return false; }
+
+        const _Fixed _T = _MulShift(_D, _Pow10Neg[_Scale]);
+        _Fixed _Q = _Horner(_LogSeries, _M::_LogTerms, _Sign ? -_T : _T);
+        if (_Base10)
+                { _Q = _Mul(_Q, _InvLn10); }
+
+        // |t| = d 10^-(n+u), where d has one digit fewer than the result
+        const int _U = _M::_Digits - 1 - _CountDigits(_D);
+        int _P = 1;
+        uint64_t _Coeff;
+        if (!_RoundFixed(_Q, _D * _Pow10[_U], _P, _M::_Digits, _M::_Log1Err,
+                         _ContextDefault(false).round, _Sign, _Coeff))
+                { return false; }
+        _Store(_Res, _Sign, -(_Scale + _U + _P), _Coeff);
+        return true;
+        }
+
+template <class _Fmt>
+static bool _FastLogFmt(const _Fmt & _X, _Fmt & _Res, bool _Base10)
+        {
+        typedef _MathFmt<_Fmt> _M;
+        _Native64 _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _N._Sign || _N._Coeff == 0)
+                { return false; }
+
+        // x = m 10^e, with 1/sqrt(10) <= m < sqrt(10) and m = c 10^-n;
+        // the log10() of a power of ten is exact
+        const uint64_t _C = _N._Coeff;
+        const int _D = _CountDigits(_C);
+        if (_Base10 && _C == _Pow10[_D - 1])
+                { return false; }
+        int _E = _N._Exp + _D - 1;
+        int _Scale = _D - 1;
+        if (_C >= _Sqrt10[_D])
+                {
+                ++_E;
+                ++_Scale;
+                }
+        _Fixed _Y = _MulShift(_C, _Pow10Neg[_Scale]);
+
+        // m = 2^a y, with 3/4 <= y < 3/2
+        int _A = 0;
+        while (_Y < 3 * (_One >> 2))
+                {
+                _Y <<= 1;
+                --_A;
+                }
+        while (_Y >= 3 * (_One >> 1))
+                {
+                _Y >>= 1;
+                ++_A;
+                }
+
+        // y = (j1/32) (1 + j2/1024) (1 + t), with |t| about 2^-11 at most
+        const int _J1 = static_cast<int>((_Y + (_One >> 6)) >>
+                                         (_FracBits - 5));
+        _Y = _Mul(_Y, _LogRecip1[_J1 - 24]);
+        const int _J2 = static_cast<int>((_Y - _One + (_One >> 11)) >>
+                                         (_FracBits - 10));
+        if (_E == 0 && _A == 0 && _J1 == 32 && _J2 == 0)
+                { return _LogNearOne(_C, _Scale, _Base10, _Res); }
+        const _Fixed _T = _Mul(_Y, _LogRecip2[_J2 + 22]) - _One;
+
+        _Fixed _L = _LogTable1[_J1 - 24] + _LogTable2[_J2 + 22] +
+                    _Mul(_T, _Horner(_LogSeries, _M::_LogTerms, _T)) +
+                    _A * _Ln2;
+        if (_Base10)
+                {
+                _L = (static_cast<_Fixed>(_E) << _FracBits) +
+                     _Mul(_L, _InvLn10);
+                }
+        else
+                { _L += _E * _Ln10; }
+
+        int _P = _M::_Digits - 1;
+        uint64_t _Coeff;
+        if (!_RoundFixed(_L < 0 ? -_L : _L, 1, _P, _M::_Digits, _M::_LogErr,
+                         _ContextDefault(false).round, _L < 0 ? 1 : 0,
+                         _Coeff))
+                { return false; }
+        _Store(_Res, _L < 0 ? 1 : 0, -_P, _Coeff);
+        return true;
+        }
+
+// Square root.  The coefficient is scaled to 2 p - 1 or 2 p digits, so
+// that its integer square root has the p digits of the format; a double
+// estimate of that root is corrected in integer arithmetic.  The
+// remainder shows whether the root is exact and, as it is never a tie,
+// which way to round.
+template <class _Fmt>
+static bool _FastSqrtFmt(const _Fmt & _X, _Fmt & _Res)
+        {
+        typedef _MathFmt<_Fmt> _M;
+        _Native64 _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _N._Sign != 0 || _N._Coeff == 0)
+                { return false; }
+
+        // decNumber gives even the exact roots of subnormal numbers all
+        // p digits, so those are left to it
+        const int _Count = _CountDigits(_N._Coeff);
+        if (_N._Exp + _Count - 1 < _M::_Emin)
+                { return false; }
+
+        // c 10^s, with e - s even
+        int _S = 2 * _M::_Digits - _Count;
+        if ((_N._Exp - _S) & 1)
+                { --_S; }
+        const int _S1 = _S < 19 ? _S : 19;
+        const _UFixed _C = static_cast<_UFixed>(_N._Coeff) * _Pow10[_S1] *
+                           _Pow10[_S - _S1];
+
+        uint64_t _Q =
+                static_cast<uint64_t>(std::sqrt(static_cast<double>(_C)));
+        _UFixed _Sq = static_cast<_UFixed>(_Q) * _Q;
+        while (_Sq > _C)
+                {
+                --_Q;
+                _Sq = static_cast<_UFixed>(_Q) * _Q;
+                }
+        while (_C - _Sq > 2 * static_cast<_UFixed>(_Q))
+                {
+                ++_Q;
+                _Sq = static_cast<_UFixed>(_Q) * _Q;
+                }
+
+        int _Exp = (_N._Exp - _S) / 2;
+        const _UFixed _Rem = _C - _Sq;
+        if (_Rem == 0)
+                {
+                // exact, with the exponent as near floor(e / 2) as the
+                // digits allow, as in decNumber
+                const int _Ideal = (_N._Exp - (_N._Exp & 1)) / 2;
+                while (_Exp < _Ideal && _Q % 10 == 0)
+                        {
+                        _Q /= 10;
+                        ++_Exp;
+                        }
+                }
+        else if (_Rem > _Q)
+                {
+                // above q + 1/2
+                if (++_Q == _Pow10[_M::_Digits])
+                        {
+                        _Q /= 10;
+                        ++_Exp;
+                        }
+                }
+        _Store(_Res, 0, _Exp, _Q);
+        return true;
+        }
+
+// 10^_N as a 128-bit integer, for _N up to 38
+static _UFixed _Pow10Wide(int _N)
+        {
+        return _N <= 19 ? static_cast<_UFixed>(_Pow10[_N]) :
+                          static_cast<_UFixed>(_Pow10[19]) * _Pow10[_N - 19];
+        }
+
+// the number of digits of _V, which is less than 10^38
+static int _CountDigitsWide(_UFixed _V)
+        {
+        if ((_V >> 64) == 0)
+                { return _CountDigits(static_cast<uint64_t>(_V)); }
+        int _N = 20;
+        while (_V >= _Pow10Wide(_N))
+                { ++_N; }
+        return _N;
+        }
+
+// Fused multiply-add.  The product of the coefficients is exact in 128
+// bits.  The product and z are brought to a common exponent: the one
+// with the larger exponent is scaled up while it stays below 10^37, and
+// the other is then scaled down; any digits that fall off lie far below
+// those of the result, and only make it inexact.  The sum is rounded
+// once in the current rounding mode.
+template <class _Fmt>
+static bool _FastFmaFmt(const _Fmt & _X, const _Fmt & _Y, const _Fmt & _Z,
+                        _Fmt & _Res)
+        {
+        typedef _MathFmt<_Fmt> _M;
+        _Native64 _NX, _NY, _NZ;
+        _Unpack(_X, _NX);
+        _Unpack(_Y, _NY);
+        _Unpack(_Z, _NZ);
+        if (_NX._Kind != _NativeFinite || _NY._Kind != _NativeFinite ||
+            _NZ._Kind != _NativeFinite)
+                { return false; }
+
+        _UFixed _A = static_cast<_UFixed>(_NX._Coeff) * _NY._Coeff;
+        int _EA = _NX._Exp + _NY._Exp;
+        unsigned _SA = _NX._Sign ^ _NY._Sign;
+        _UFixed _B = _NZ._Coeff;
+        int _EB = _NZ._Exp;
+        unsigned _SB = _NZ._Sign;
+        if (_EA < _EB)
+                {
+                const _UFixed _TC = _A;
+                _A = _B;
+                _B = _TC;
+                const int _TE = _EA;
+                _EA = _EB;
+                _EB = _TE;
+                const unsigned _TS = _SA;
+                _SA = _SB;
+                _SB = _TS;
+                }
+
+        const int _D = _EA - _EB;
+        int _K = _D;
+        if (_A != 0)
+                {
+                if (_K > 37 - _CountDigitsWide(_A))
+                        { _K = 37 - _CountDigitsWide(_A); }
+                _A *= _Pow10Wide(_K);
+                }
+        int _Exp = _EA - _K;
+        bool _Sticky = false;
+        if (_D > _K)
+                {
+                if (_D - _K > 38)
+                        {
+                        _Sticky = _B != 0;
+                        _B = 0;
+                        }
+                else
+                        {
+                        const _UFixed _P = _Pow10Wide(_D - _K);
+                        const _UFixed _Q = _B / _P;
+                        _Sticky = _B != _Q * _P;
+                        _B = _Q;
+                        }
+                }
+
+        // the magnitude of the sum; when _B is inexact, _A is above
+        // 10^36 and _B below 10^32
+        _UFixed _S;
+        unsigned _Sign = _SA;
+        if (_SA == _SB)
+                { _S = _A + _B; }
+        else if (_A >= _B)
+                { _S = _A - _B - (_Sticky ? 1 : 0); }
+        else
+                {
+                _S = _B - _A;
+                _Sign = _SB;
+                }
+        if (_S == 0 && !_Sticky)
+                {
+                // the sign of an exact zero depends on the rounding mode
+                return false;
+                }
+
+        const int _N = _CountDigitsWide(_S);
+        uint64_t _Coeff;
+        if (_N <= _M::_Digits)
+                { _Coeff = static_cast<uint64_t>(_S); }
+        else
+                {
+                int _Drop = _N - _M::_Digits;
+                const _UFixed _P = _Pow10Wide(_Drop - 1);
+                const uint64_t _Q = static_cast<uint64_t>(_S / _P);
+                _Sticky = _Sticky || _S != _Q * _P;
+                _Coeff = _Q / 10;
+                if (_RoundsUp(_ContextDefault(false).round, _Sign,
+                              static_cast<unsigned>(_Coeff % 10),
+                              static_cast<unsigned>(_Q % 10), _Sticky) &&
+                    ++_Coeff == _Pow10[_M::_Digits])
+                        {
+                        _Coeff /= 10;
+                        ++_Drop;
+                        }
+                _Exp += _Drop;
+                }
+
+        // subnormal results, and those that overflow or must be clamped,
+        // are left to decNumber
+        if (_Exp + _CountDigits(_Coeff) - 1 < _M::_Emin ||
+            _Exp > _M::_Emax - (_M::_Digits - 1))
+                { return false; }
+        _Store(_Res, _Sign, _Exp, _Coeff);
+        return true;
+        }
+
+bool _FastExp(const decimal32 & _X, decimal32 & _Res)
+        { return _FastExpFmt(_X, _Res); }
+
+bool _FastExp(const decimal64 & _X, decimal64 & _Res)
+        { return _FastExpFmt(_X, _Res); }
+
+bool _FastLog(const decimal32 & _X, decimal32 & _Res)
+        { return _FastLogFmt(_X, _Res, false); }
+
+bool _FastLog(const decimal64 & _X, decimal64 & _Res)
+        { return _FastLogFmt(_X, _Res, false); }
+
+bool _FastLog10(const decimal32 & _X, decimal32 & _Res)
+        { return _FastLogFmt(_X, _Res, true); }
+
+bool _FastLog10(const decimal64 & _X, decimal64 & _Res)
+        { return _FastLogFmt(_X, _Res, true); }
+
+bool _FastSqrt(const decimal32 & _X, decimal32 & _Res)
+        { return _FastSqrtFmt(_X, _Res); }
+
+bool _FastSqrt(const decimal64 & _X, decimal64 & _Res)
+        { return _FastSqrtFmt(_X, _Res); }
+
+bool _FastFma(const decimal32 & _X, const decimal32 & _Y,
+              const decimal32 & _Z, decimal32 & _Res)
+        { return _FastFmaFmt(_X, _Y, _Z, _Res); }
+
+bool _FastFma(const decimal64 & _X, const decimal64 & _Y,
+              const decimal64 & _Z, decimal64 & _Res)
+        { return _FastFmaFmt(_X, _Y, _Z, _Res); }
+
+#else
+
+bool _FastExp(const decimal32 &, decimal32 &)
+        { return false; }
+
+bool _FastExp(const decimal64 &, decimal64 &)
+        { return false; }
+
+bool _FastLog(const decimal32 &, decimal32 &)
+        { return false; }
+
+bool _FastLog(const decimal64 &, decimal64 &)
+        { return false; }
+
+bool _FastLog10(const decimal32 &, decimal32 &)
+        { return false; }
+
+bool _FastLog10(const decimal64 &, decimal64 &)
+        { return false; }
+
+bool _FastSqrt(const decimal32 &, decimal32 &)
+        { return false; }
+
+bool _FastSqrt(const decimal64 &, decimal64 &)
+        { return false; }
+
+bool _FastFma(const decimal32 &, const decimal32 &, const decimal32 &,
+              decimal32 &)
+        { return false; }
+
+bool _FastFma(const decimal64 &, const decimal64 &, const decimal64 &,
+              decimal64 &)
+        { return false; }
+
+#endif /* defined(_DEC_HAS_INT128) */
+
+// Numbers in base 10^9 limbs, least significant first, with _N limbs in
+// use.  The integer powers work on these, so that cutting a product
+// back to the working precision is a matter of dropping limbs.
+static const uint32_t _LimbBase = 1000000000;
+static const int      _MaxLimbs = 12;
+
+struct _Limbs {
+        int      _N;
+        uint32_t _L[_MaxLimbs];
+};
+
+// The parameters of each format for pow().  A power is carried to
+// _Keep limbs, and the results fit the format with exponents between
+// _MinExp and _MaxExp.
+template <class _Fmt>
+struct _PowFmt;
+
+template <>
+struct _PowFmt<decimal32> {
+        typedef _Native64 _Native;
+        static const int _Digits = 7;
+        static const int _Keep   = 3;
+        static const int _MinExp = -101;
+        static const int _MaxExp = 90;
+};
+
+template <>
+struct _PowFmt<decimal64> {
+        typedef _Native64 _Native;
+        static const int _Digits = 16;
+        static const int _Keep   = 4;
+        static const int _MinExp = -398;
+        static const int _MaxExp = 369;
+};
+
+template <>
+struct _PowFmt<decimal128> {
+        typedef _Native128 _Native;
+        static const int _Digits = 34;
+        static const int _Keep   = 6;
+        static const int _MinExp = -6176;
+        static const int _MaxExp = 6111;
+};
+
+static void _Trim(_Limbs & _A)
+        {
+        while (_A._N > 1 && _A._L[_A._N - 1] == 0)
+                { --_A._N; }
+        }
+
+static void _SetLimbs(_Limbs & _A, uint64_t _V)
+        {
+        _A._N = 0;
+        do
+                {
+                _A._L[_A._N++] = static_cast<uint32_t>(_V % _LimbBase);
+                _V /= _LimbBase;
+                }
+        while (_V != 0);
+        }
+
+static void _SetLimbs(_Limbs & _A, _Uint128 _V)
+        {
+        _A._N = 0;
+        do
+                { _A._L[_A._N++] = _DivSmall(_V, _LimbBase); }
+        while (_V._Hi != 0 || _V._Lo != 0);
+        }
+
+static void _GetLimbs(const _Limbs & _A, uint64_t & _V)
+        {
+        _V = 0;
+        for (int _I = _A._N - 1; _I >= 0; --_I)
+                { _V = _V * _LimbBase + _A._L[_I]; }
+        }
+
+static void _GetLimbs(const _Limbs & _A, _Uint128 & _V)
+        {
+        _V = _MakeUint128(0, 0);
+        for (int _I = _A._N - 1; _I >= 0; --_I)
+                {
+                const uint64_t _Hi = _V._Hi * _LimbBase;
+                _V = _Add64(_Mul64(_V._Lo, _LimbBase), _A._L[_I]);
+                _V._Hi += _Hi;
+                }
+        }
+
+static bool _IsZero(uint64_t _C)
+        { return _C == 0; }
+
+static bool _IsZero(const _Uint128 & _C)
+        { return _C._Hi == 0 && _C._Lo == 0; }
+
+// the number of digits of _A, which is not zero
+static int _LimbDigits(const _Limbs & _A)
+        { return 9 * (_A._N - 1) + _CountDigits(_A._L[_A._N - 1]); }
+
+static double _LimbValue(const _Limbs & _A)
+        {
+        double _D = 0;
+        for (int _I = _A._N - 1; _I >= 0; --_I)
+                { _D = _D * _LimbBase + _A._L[_I]; }
+        return _D;
+        }
+
+static int _CompareLimbs(const _Limbs & _A, const _Limbs & _B)
+        {
+        if (_A._N != _B._N)
+                { return _A._N < _B._N ? -1 : 1; }
+        for (int _I = _A._N - 1; _I >= 0; --_I)
+                {
+                if (_A._L[_I] != _B._L[_I])
+                        { return _A._L[_I] < _B._L[_I] ? -1 : 1; }
+                }
+        return 0;
+        }
+
+static void _AddLimbs(_Limbs & _A, const _Limbs & _B)
+        {
+        const int _N = _A._N > _B._N ? _A._N : _B._N;
+        uint32_t _Carry = 0;
+        for (int _I = 0; _I != _N; ++_I)
+                {
+                uint32_t _T = (_I < _A._N ? _A._L[_I] : 0) +
+                              (_I < _B._N ? _B._L[_I] : 0) + _Carry;
+                _Carry = _T >= _LimbBase ? 1 : 0;
+                _A._L[_I] = _Carry ? _T - _LimbBase : _T;
+                }
+        _A._N = _N;
+        if (_Carry)
+                { _A._L[_A._N++] = 1; }
+        }
+
+// _A -= _B, where _A >= _B
+static void _SubLimbs(_Limbs & _A, const _Limbs & _B)
+        {
+        uint32_t _Borrow = 0;
+        for (int _I = 0; _I != _A._N; ++_I)
+                {
+                const uint32_t _T = (_I < _B._N ? _B._L[_I] : 0) + _Borrow;
+                _Borrow = _A._L[_I] < _T ? 1 : 0;
+                _A._L[_I] = _Borrow ? _A._L[_I] + _LimbBase - _T :
+                                      _A._L[_I] - _T;
+                }
+        _Trim(_A);
+        }
+
+// _P = _A * _B, a column at a time: a column has at most _MaxLimbs / 2
+// products, each below 10^18, so it is carried only once
+static void _MulLimbs(const _Limbs & _A, const _Limbs & _B, _Limbs & _P)
+        {
+        _P._N = _A._N + _B._N;
+        uint64_t _Carry = 0;
+        for (int _K = 0; _K != _P._N - 1; ++_K)
+                {
+                uint64_t _T = _Carry;
+                const int _First = _K < _B._N ? 0 : _K - _B._N + 1;
+                const int _Last = _K < _A._N ? _K : _A._N - 1;
+                for (int _I = _First; _I <= _Last; ++_I)
+                        {
+                        _T += static_cast<uint64_t>(_A._L[_I]) *
+                              _B._L[_K - _I];
+                        }
+                _P._L[_K] = static_cast<uint32_t>(_T % _LimbBase);
+                _Carry = _T / _LimbBase;
+                }
+        _P._L[_P._N - 1] = static_cast<uint32_t>(_Carry);
+        _Trim(_P);
+        }
+
+static void _MulLimbs(const _Limbs & _A, uint32_t _M, _Limbs & _P)
+        {
+        uint64_t _Carry = 0;
+        for (int _I = 0; _I != _A._N; ++_I)
+                {
+                const uint64_t _T =
+                        static_cast<uint64_t>(_A._L[_I]) * _M + _Carry;
+                _P._L[_I] = static_cast<uint32_t>(_T % _LimbBase);
+                _Carry = _T / _LimbBase;
+                }
+        _P._N = _A._N;
+        if (_Carry != 0)
+                { _P._L[_P._N++] = static_cast<uint32_t>(_Carry); }
+        _Trim(_P);
+        }
+
+// divides _A by _D in place; returns the remainder
+static uint32_t _DivLimbs(_Limbs & _A, uint32_t _D)
+        {
+        uint64_t _R = 0;
+        for (int _I = _A._N - 1; _I >= 0; --_I)
+                {
+                const uint64_t _T = _R * _LimbBase + _A._L[_I];
+                _A._L[_I] = static_cast<uint32_t>(_T / _D);
+                _R = _T % _D;
+                }
+        _Trim(_A);
+        return static_cast<uint32_t>(_R);
+        }
+
+// drops the _Count low limbs of _A; returns true if any was nonzero
+static bool _DropLimbs(_Limbs & _A, int _Count)
+        {
+        if (_Count >= _A._N)
+                {
+                const bool _Nonzero = _A._N != 1 || _A._L[0] != 0;
+                _A._N = 1;
+                _A._L[0] = 0;
+                return _Nonzero;
+                }
+        bool _Nonzero = false;
+        for (int _I = 0; _I != _Count; ++_I)
+                { _Nonzero = _Nonzero || _A._L[_I] != 0; }
+        for (int _I = _Count; _I != _A._N; ++_I)
+                { _A._L[_I - _Count] = _A._L[_I]; }
+        _A._N -= _Count;
+        return _Nonzero;
+        }
+
+// cuts _A back to _Keep limbs, raising its exponent _Exp; sets _Inexact
+// if a nonzero limb is dropped
+static void _CutLimbs(_Limbs & _A, int _Keep, long long & _Exp,
+                      bool & _Inexact)
+        {
+        const int _Drop = _A._N - _Keep;
+        if (_Drop > 0)
+                {
+                _Inexact = _DropLimbs(_A, _Drop) || _Inexact;
+                _Exp += 9LL * _Drop;
+                }
+        }
+
+// The integer part of 10^_S / _C, where _C has at most four limbs.
+// Each limb of the quotient is estimated in floating point and then
+// corrected.
+static bool _Reciprocal(const _Limbs & _C, int _S, _Limbs & _Q)
+        {
+        const double _CD = _LimbValue(_C);
+        _Limbs _R, _T;
+        _R._N = 1;
+        _R._L[0] = 0;
+        _Q._N = _S / 9 + 1;
+        for (int _I = _Q._N - 1; _I >= 0; --_I)
+                {
+                for (int _J = _R._N; _J != 0; --_J)
+                        { _R._L[_J] = _R._L[_J - 1]; }
+                _R._L[0] = _I == _Q._N - 1 ?
+                           static_cast<uint32_t>(_Pow10[_S % 9]) : 0;
+                ++_R._N;
+                _Trim(_R);
+
+                double _E = _LimbValue(_R) / _CD;
+                uint32_t _D = _E < _LimbBase ? static_cast<uint32_t>(_E) :
+                                               _LimbBase - 1;
+                _MulLimbs(_C, _D, _T);
+                while (_CompareLimbs(_T, _R) > 0)
+                        {
+                        _SubLimbs(_T, _C);
+                        --_D;
+                        }
+                _SubLimbs(_R, _T);
+                while (_CompareLimbs(_R, _C) >= 0)
+                        {
+                        _SubLimbs(_R, _C);
+                        ++_D;
+                        }
+                _Q._L[_I] = _D;
+                }
+        _Trim(_Q);
+        return _R._N == 1 && _R._L[0] == 0;
+        }
+
+// Rounds _A to drop its _Drop (at least one) low digits.
+static void _RoundLimbs(_Limbs _A, int _Drop, rounding _Mode, unsigned _Sign,
+                        _Limbs & _Res)
+        {
+        bool _Sticky = _DropLimbs(_A, (_Drop - 1) / 9);
+        _Sticky = _DivLimbs(_A, static_cast<uint32_t>(
+                                    _Pow10[(_Drop - 1) % 9])) != 0 ||
+                  _Sticky;
+        const unsigned _First = _DivLimbs(_A, 10);
+        if (_RoundsUp(_Mode, _Sign, _A._L[0] % 10, _First, _Sticky))
+                {
+                _Limbs _One;
+                _SetLimbs(_One, static_cast<uint64_t>(1));
+                _AddLimbs(_A, _One);
+                }
+        _Res = _A;
+        }
+
+template <class _Fmt>
+static void _StorePow(_Fmt & _Res, unsigned _Sign, int _Exp, const _Limbs & _C)
+        {
+        typename _PowFmt<_Fmt>::_Native _N;
+        _N._Sign = _Sign;
+        _N._Kind = _NativeFinite;
+        _N._Exp = _Exp;
+        _GetLimbs(_C, _N._Coeff);
+        _Pack(_Res, _N);
+        }
+
+template <class _Fmt>
+static bool _FastPowFmt(const _Fmt & _X, int _Pow, _Fmt & _Res)
+        {
+        typedef _PowFmt<_Fmt> _F;
+        typename _F::_Native _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _IsZero(_N._Coeff))
+                { return false; }
+
+        const unsigned _Sign = _N._Sign & static_cast<unsigned>(_Pow);
+        const unsigned _Abs = _Pow < 0 ? 0U - static_cast<unsigned>(_Pow) :
+                                         static_cast<unsigned>(_Pow);
+        _Limbs _Base;
+        _SetLimbs(_Base, _N._Coeff);
+        long long _BaseExp = _N._Exp;
+        bool _Inexact = false;
+        if (_Pow < 0)
+                {
+                // x^-n is (1/x)^n, as in decNumber; an exact reciprocal
+                // has the exponent of a division
+                const int _S = 9 * (_F::_Keep - 1) + _LimbDigits(_Base);
+                _Limbs _Q;
+                _Inexact = !_Reciprocal(_Base, _S, _Q);
+                _BaseExp = -_S - _BaseExp;
+                while (!_Inexact && _BaseExp < -_N._Exp && _Q._L[0] % 10 == 0)
+                        {
+                        _DivLimbs(_Q, 10);
+                        ++_BaseExp;
+                        }
+                _Base = _Q;
+                }
+
+        // left to right binary powering, cut back to _Keep limbs
+        _Limbs _Acc, _T;
+        _SetLimbs(_Acc, static_cast<uint64_t>(1));
+        long long _Exp = 0;
+        if (_Abs != 0)
+                {
+                int _Bit = 0;
+                while ((_Abs >> _Bit) > 1)
+                        { ++_Bit; }
+                _Acc = _Base;
+                _Exp = _BaseExp;
+                while (_Bit-- != 0)
+                        {
+                        _MulLimbs(_Acc, _Acc, _T);
+                        _Exp *= 2;
+                        _CutLimbs(_T, _F::_Keep, _Exp, _Inexact);
+                        if ((_Abs >> _Bit) & 1)
+                                {
+                                _MulLimbs(_T, _Base, _Acc);
+                                _Exp += _BaseExp;
+                                _CutLimbs(_Acc, _F::_Keep, _Exp, _Inexact);
+                                }
+                        else
+                                { _Acc = _T; }
+                        }
+                }
+
+        // round once; an inexact power is in error by less than 4 |n|
+        // parts in 10^(9 (_Keep - 1)), and the result is decided if both
+        // ends of that interval round alike
+        const rounding _Mode = _ContextDefault(false).round;
+        const int _Drop = _LimbDigits(_Acc) - _F::_Digits;
+        _Limbs _Coeff = _Acc;
+        if (_Inexact)
+                {
+                const int _Spare = _LimbDigits(_Acc) - 9 * (_F::_Keep - 1);
+                _Limbs _Err, _Lo = _Acc, _Hi = _Acc, _Other;
+                _SetLimbs(_Err, 4ULL * _Abs * _Pow10[_Spare] + 1);
+                _SubLimbs(_Lo, _Err);
+                _AddLimbs(_Hi, _Err);
+                _RoundLimbs(_Lo, _Drop, _Mode, _Sign, _Coeff);
+                _RoundLimbs(_Hi, _Drop, _Mode, _Sign, _Other);
+                if (_CompareLimbs(_Coeff, _Other) != 0)
+                        { return false; }
+                }
+        else if (_Drop > 0)
+                { _RoundLimbs(_Acc, _Drop, _Mode, _Sign, _Coeff); }
+        if (_Drop > 0)
+                {
+                _Exp += _Drop;
+                if (_LimbDigits(_Coeff) > _F::_Digits)
+                        {
+                        _DivLimbs(_Coeff, 10);
+                        ++_Exp;
+                        }
+                }
+
+        // results that overflow, are subnormal or must be clamped are
+        // left to decNumber
+        if (_Exp < _F::_MinExp || _Exp > _F::_MaxExp)
+                { return false; }
+        _StorePow(_Res, _Sign, static_cast<int>(_Exp), _Coeff);
+        return true;
+        }
+
+bool _FastPow(const decimal32 & _X, int _N, decimal32 & _Res)
+        { return _FastPowFmt(_X, _N, _Res); }
+
+bool _FastPow(const decimal64 & _X, int _N, decimal64 & _Res)
+        { return _FastPowFmt(_X, _N, _Res); }
+
+bool _FastPow(const decimal128 & _X, int _N, decimal128 & _Res)
+        { return _FastPowFmt(_X, _N, _Res); }
+
+// Drops the _Drop (at least one) low digits of the coefficient of _N,
+// rounding in _Mode, and raises its exponent to match.
+static void _DropDigits(_Native64 & _N, int _Drop, rounding _Mode)
+        {
+        if (_Drop > 19)
+                {
+                // every digit is dropped, the first of them a zero
+                _N._Coeff = _RoundsUp(_Mode, _N._Sign, 0, 0, _N._Coeff != 0) ?
+                            1 : 0;
+                }
+        else
+                {
+                const uint64_t _R = _N._Coeff % _Pow10[_Drop];
+                _N._Coeff /= _Pow10[_Drop];
+                if (_R != 0 &&
+                    _RoundsUp(_Mode, _N._Sign,
+                              static_cast<unsigned>(_N._Coeff % 10),
+                              static_cast<unsigned>(_R / _Pow10[_Drop - 1]),
+                              _R % _Pow10[_Drop - 1] != 0))
+                        { ++_N._Coeff; }
+                }
+        _N._Exp += _Drop;
+        }
+
+static void _DropDigits(_Native128 & _N, int _Drop, rounding _Mode)
+        {
+        bool _Sticky = false;
+        unsigned _First = 0;
+        if (_Drop > 34)
+                {
+                _Sticky = !_IsZero(_N._Coeff);
+                _N._Coeff = _MakeUint128(0, 0);
+                }
+        else
+                {
+                // the digits below the first dropped one, nine at a time
+                for (int _K = _Drop - 1; _K != 0; )
+                        {
+                        const int _Step = _K < 9 ? _K : 9;
+                        const uint32_t _D =
+                                static_cast<uint32_t>(_Pow10[_Step]);
+                        _Sticky = _DivSmall(_N._Coeff, _D) != 0 || _Sticky;
+                        _K -= _Step;
+                        }
+                _First = _DivSmall(_N._Coeff, 10);
+                }
+        if (_First != 0 || _Sticky)
+                {
+                _Uint128 _T = _N._Coeff;
+                if (_RoundsUp(_Mode, _N._Sign, _DivSmall(_T, 10), _First,
+                              _Sticky))
+                        { _N._Coeff = _Add64(_N._Coeff, 1); }
+                }
+        _N._Exp += _Drop;
+        }
+
+// Quantize to the exponent _Q, which must be that of a finite value of
+// the format, by scaling the coefficient by a power of ten.  Results
+// that would need more digits than the format has are left to decNumber,
+// which makes them NaNs.
+template <class _Fmt>
+static bool _FastQuantizeFmt(const _Fmt & _X, int _Q, _Fmt & _Res)
+        {
+        typedef _PowFmt<_Fmt> _F;
+        _Native64 _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _Q < _F::_MinExp || _Q > _F::_MaxExp)
+                { return false; }
+
+        const int _Adjust = _Q - _N._Exp;
+        if (_Adjust > 0)
+                { _DropDigits(_N, _Adjust, _ContextDefault(false).round); }
+        else if (_N._Coeff != 0)
+                {
+                if (_CountDigits(_N._Coeff) - _Adjust > _F::_Digits)
+                        { return false; }
+                _N._Coeff *= _Pow10[-_Adjust];
+                }
+        _N._Exp = _Q;
+        _Pack(_Res, _N);
+        return true;
+        }
+
+// Rounds to an integral value in _Mode; a value with an exponent of
+// zero or more is already integral, and is returned as it is.
+template <class _Fmt>
+static bool _FastToIntegralFmt(const _Fmt & _X, rounding _Mode, _Fmt & _Res)
+        {
+        typename _PowFmt<_Fmt>::_Native _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite)
+                { return false; }
+        if (_N._Exp >= 0)
+                {
+                _Res = _X;
+                return true;
+                }
+        _DropDigits(_N, -_N._Exp, _Mode);
+        _Pack(_Res, _N);
+        return true;
+        }
+
+// The number of digits of the coefficient _C, which is not zero.  A
+// coefficient of decimal128 needs at most two divisions to fit 64 bits.
+static int _CoeffDigits(uint64_t _C)
+        { return _CountDigits(_C); }
+
+static int _CoeffDigits(const _Uint128 & _C)
+        {
+        _Uint128 _T = _C;
+        int _N = 0;
+        while (_T._Hi != 0)
+                {
+                _DivSmall(_T, _LimbBase);
+                _N += 9;
+                }
+        return _N + _CountDigits(_T._Lo);
+        }
+
+// sets _N to the integer _V, with an exponent of zero
+static void _SetIntegral(_Native64 & _N, long long _V)
+        {
+        _N._Kind = _NativeFinite;
+        _N._Sign = _V < 0;
+        _N._Exp = 0;
+        _N._Coeff = _V < 0 ? 0 - static_cast<uint64_t>(_V) : _V;
+        }
+
+static void _SetIntegral(_Native128 & _N, long long _V)
+        {
+        _N._Kind = _NativeFinite;
+        _N._Sign = _V < 0;
+        _N._Exp = 0;
+        _N._Coeff = _MakeUint128(0, _V < 0 ? 0 - static_cast<uint64_t>(_V) :
+                                             _V);
+        }
+
+// The exponent of the most significant digit of _X, which is the
+// exponent of its last digit plus the number of digits less one.
+// Returns false for zeros and specials.
+template <class _Fmt>
+static bool _FastIlogbFmt(const _Fmt & _X, int & _Res)
+        {
+        typename _PowFmt<_Fmt>::_Native _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite || _IsZero(_N._Coeff))
+                { return false; }
+        _Res = _N._Exp + _CoeffDigits(_N._Coeff) - 1;
+        return true;
+        }
+
+template <class _Fmt>
+static bool _FastLogbFmt(const _Fmt & _X, _Fmt & _Res)
+        {
+        int _E;
+        if (!_FastIlogbFmt(_X, _E))
+                { return false; }
+        typename _PowFmt<_Fmt>::_Native _N;
+        _SetIntegral(_N, _E);
+        _Pack(_Res, _N);
+        return true;
+        }
+
+// Splits _X into a fraction in [0.1, 1), with the coefficient of _X,
+// and a power of ten.  Zeros and specials are returned as they are,
+// with a power of zero.
+template <class _Fmt>
+static void _FrexpFmt(const _Fmt & _X, _Fmt & _Res, int & _Pow)
+        {
+        typename _PowFmt<_Fmt>::_Native _N;
+        _Unpack(_X, _N);
+        _Res = _X;
+        _Pow = 0;
+        if (_N._Kind != _NativeFinite || _IsZero(_N._Coeff))
+                { return; }
+        const int _Digits = _CoeffDigits(_N._Coeff);
+        _Pow = _N._Exp + _Digits;
+        _N._Exp = -_Digits;
+        _Pack(_Res, _N);
+        }
+
+// Multiplies _X by ten to the power _Pow by adjusting its exponent.  The
+// exponent of a zero is clamped to the range of the format; nonzero
+// results that would overflow, underflow or need clamping are left to
+// decNumber, which rounds them.
+template <class _Fmt>
+static bool _FastScalbnFmt(const _Fmt & _X, long _Pow, _Fmt & _Res)
+        {
+        typedef _PowFmt<_Fmt> _F;
+        typename _F::_Native _N;
+        _Unpack(_X, _N);
+        if (_N._Kind != _NativeFinite)
+                { return false; }
+
+        // a larger step takes every exponent out of range
+        const long _Span = _F::_MaxExp - _F::_MinExp;
+        const bool _Zero = _IsZero(_N._Coeff);
+        if (!_Zero && (_Pow > _Span || _Pow < -_Span))
+                { return false; }
+        const long _Clamped = _Pow > _Span ? _Span :
+                              _Pow < -_Span ? -_Span : _Pow;
+        const long _Exp = _N._Exp + _Clamped;
+        if (_Zero)
+                {
+                _N._Exp = _Exp < _F::_MinExp ? _F::_MinExp :
+                          _Exp > _F::_MaxExp ? _F::_MaxExp :
+                          static_cast<int>(_Exp);
+                }
+        else if (_Exp < _F::_MinExp || _Exp > _F::_MaxExp)
+                { return false; }
+        else
+                { _N._Exp = static_cast<int>(_Exp); }
+        _Pack(_Res, _N);
+        return true;
+        }
+
+// the exponent of _Y, if it is finite
+template <class _Fmt>
+static bool _QuantumOf(const _Fmt & _Y, int & _Q)
+        {
+        _Native64 _N;
+        _Unpack(_Y, _N);
+        _Q = _N._Exp;
+        return _N._Kind == _NativeFinite;
+        }
+
+bool _FastQuantize(const decimal32 & _X, int _Q, decimal32 & _Res)
+        { return _FastQuantizeFmt(_X, _Q, _Res); }
+
+bool _FastQuantize(const decimal64 & _X, int _Q, decimal64 & _Res)
+        { return _FastQuantizeFmt(_X, _Q, _Res); }
+
+bool _FastQuantize(const decimal32 & _X, const decimal32 & _Y,
+                   decimal32 & _Res)
+        {
+        int _Q;
+        return _QuantumOf(_Y, _Q) && _FastQuantizeFmt(_X, _Q, _Res);
+        }
+
+bool _FastQuantize(const decimal64 & _X, const decimal64 & _Y,
+                   decimal64 & _Res)
+        {
+        int _Q;
+        return _QuantumOf(_Y, _Q) && _FastQuantizeFmt(_X, _Q, _Res);
+        }
+
+bool _FastToIntegral(const decimal32 & _X, rounding _Mode, decimal32 & _Res)
+        { return _FastToIntegralFmt(_X, _Mode, _Res); }
+
+bool _FastToIntegral(const decimal64 & _X, rounding _Mode, decimal64 & _Res)
+        { return _FastToIntegralFmt(_X, _Mode, _Res); }
+
+bool _FastToIntegral(const decimal128 & _X, rounding _Mode,
+                     decimal128 & _Res)
+        { return _FastToIntegralFmt(_X, _Mode, _Res); }
+
+bool _FastLogb(const decimal32 & _X, decimal32 & _Res)
+        { return _FastLogbFmt(_X, _Res); }
+
+bool _FastLogb(const decimal64 & _X, decimal64 & _Res)
+        { return _FastLogbFmt(_X, _Res); }
+
+bool _FastLogb(const decimal128 & _X, decimal128 & _Res)
+        { return _FastLogbFmt(_X, _Res); }
+
+bool _FastIlogb(const decimal32 & _X, int & _Res)
+        { return _FastIlogbFmt(_X, _Res); }
+
+bool _FastIlogb(const decimal64 & _X, int & _Res)
+        { return _FastIlogbFmt(_X, _Res); }
+
+bool _FastIlogb(const decimal128 & _X, int & _Res)
+        { return _FastIlogbFmt(_X, _Res); }
+
+void _Frexp(const decimal32 & _X, decimal32 & _Res, int & _Pow)
+        { _FrexpFmt(_X, _Res, _Pow); }
+
+void _Frexp(const decimal64 & _X, decimal64 & _Res, int & _Pow)
+        { _FrexpFmt(_X, _Res, _Pow); }
+
+void _Frexp(const decimal128 & _X, decimal128 & _Res, int & _Pow)
+        { _FrexpFmt(_X, _Res, _Pow); }
+
+bool _FastScalbn(const decimal32 & _X, long _Pow, decimal32 & _Res)
+        { return _FastScalbnFmt(_X, _Pow, _Res); }
+
+bool _FastScalbn(const decimal64 & _X, long _Pow, decimal64 & _Res)
+        { return _FastScalbnFmt(_X, _Pow, _Res); }
+
+bool _FastScalbn(const decimal128 & _X, long _Pow, decimal128 & _Res)
+        { return _FastScalbnFmt(_X, _Pow, _Res); }
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,102 @@
+/* ------------------------------------------------------------------ */
+/* decMath.h header                                                   */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#ifndef _DECMATH_H
+#define _DECMATH_H
+
+#include "decimal"
+
+namespace std {
+namespace decimal {
+
+// Fast paths of exp(), log() and log10() for decimal32 and decimal64,
+// evaluated in fixed point with just the precision those formats need.
+// Each stores the result correctly rounded in the current rounding mode
+// in _Res and returns true, or returns false if the argument is special,
+// the result is exact or out of range, or the result is too close to a
+// rounding boundary to be decided; the caller then goes through
+// decNumber (see _DecNumber::_WideMathFn).
+bool _FastExp(const decimal32 & _X, decimal32 & _Res);
+bool _FastExp(const decimal64 & _X, decimal64 & _Res);
+bool _FastLog(const decimal32 & _X, decimal32 & _Res);
+bool _FastLog(const decimal64 & _X, decimal64 & _Res);
+bool _FastLog10(const decimal32 & _X, decimal32 & _Res);
+bool _FastLog10(const decimal64 & _X, decimal64 & _Res);
+
+// Likewise sqrt(), which decides every positive argument, exact or not,
+// and leaves zeros and negative arguments to decNumber.
+bool _FastSqrt(const decimal32 & _X, decimal32 & _Res);
+bool _FastSqrt(const decimal64 & _X, decimal64 & _Res);
+
+// fma(), with the product exact in 128 bits and a single rounding in the
+// current rounding mode.  Returns false for specials, exact zeros, and
+// results that are subnormal, overflow or must be clamped.
+bool _FastFma(const decimal32 & _X, const decimal32 & _Y,
+              const decimal32 & _Z, decimal32 & _Res);
+bool _FastFma(const decimal64 & _X, const decimal64 & _Y,
+              const decimal64 & _Z, decimal64 & _Res);
+
+// pow() with an integer exponent, by binary powering of the coefficient
+// at a working precision and a single rounding in the current rounding
+// mode.  Returns false, as above, for results it cannot decide and for
+// results that overflow, underflow or must be clamped.
+bool _FastPow(const decimal32 & _X, int _N, decimal32 & _Res);
+bool _FastPow(const decimal64 & _X, int _N, decimal64 & _Res);
+bool _FastPow(const decimal128 & _X, int _N, decimal128 & _Res);
+
+// quantize() of decimal32 and decimal64 to the exponent _Q, or to that of
+// _Y, in integer arithmetic.  Returns false, as above, for specials and
+// for results that do not fit.
+bool _FastQuantize(const decimal32 & _X, int _Q, decimal32 & _Res);
+bool _FastQuantize(const decimal64 & _X, int _Q, decimal64 & _Res);
+bool _FastQuantize(const decimal32 & _X, const decimal32 & _Y,
+                   decimal32 & _Res);
+bool _FastQuantize(const decimal64 & _X, const decimal64 & _Y,
+                   decimal64 & _Res);
+
+// ceil(), floor(), trunc(), round(), nearbyint() and rint(), rounding
+// to an integral value in _Mode.  Returns false for specials only.
+bool _FastToIntegral(const decimal32 & _X, rounding _Mode, decimal32 & _Res);
+bool _FastToIntegral(const decimal64 & _X, rounding _Mode, decimal64 & _Res);
+bool _FastToIntegral(const decimal128 & _X, rounding _Mode,
+                     decimal128 & _Res);
+
+// logb() and ilogb(), the exponent of the most significant digit, from
+// the exponent and the number of digits of the coefficient.  Return
+// false for zeros and specials.
+bool _FastLogb(const decimal32 & _X, decimal32 & _Res);
+bool _FastLogb(const decimal64 & _X, decimal64 & _Res);
+bool _FastLogb(const decimal128 & _X, decimal128 & _Res);
+bool _FastIlogb(const decimal32 & _X, int & _Res);
+bool _FastIlogb(const decimal64 & _X, int & _Res);
+bool _FastIlogb(const decimal128 & _X, int & _Res);
+
+// frexp(), which keeps the coefficient of _X and stores the power of ten
+// that takes it into [0.1, 1) in _Pow.  Zeros and specials are returned
+// as they are, with _Pow zero.
+void _Frexp(const decimal32 & _X, decimal32 & _Res, int & _Pow);
+void _Frexp(const decimal64 & _X, decimal64 & _Res, int & _Pow);
+void _Frexp(const decimal128 & _X, decimal128 & _Res, int & _Pow);
+
+// scalbn(), as an adjustment of the exponent.  Returns false for specials
+// and for nonzero results whose exponent is out of range.
+bool _FastScalbn(const decimal32 & _X, long _Pow, decimal32 & _Res);
+bool _FastScalbn(const decimal64 & _X, long _Pow, decimal64 & _Res);
+bool _FastScalbn(const decimal128 & _X, long _Pow, decimal128 & _Res);
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECMATH_H */
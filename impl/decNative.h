@@ -0,0 +1,658 @@
+/* ------------------------------------------------------------------ */
+/* decNative.h header                                                 */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+// Direct access to the sign, coefficient and exponent of the decimal
+// encodings, without a round trip through decNumber.  This is the
+// basis of the fast paths and bulk conversions of the library.
+
+#ifndef _DECNATIVE_H
+#define _DECNATIVE_H
+
+#include <cstring>
+
+#include "decimal"
+
+// DPD tables of the decNumber library (see decDPD.h)
+extern "C" {
+extern const unsigned short DPD2BIN[1024];
+extern const unsigned short BIN2DPD[1000];
+}
+
+namespace std {
+namespace decimal {
+
+// a 128-bit unsigned integer
+struct _Uint128 {
+        uint64_t _Hi;
+        uint64_t _Lo;
+};
+
+inline _Uint128 _MakeUint128(uint64_t _Hi, uint64_t _Lo)
+        {
+        _Uint128 _R;
+        _R._Hi = _Hi;
+        _R._Lo = _Lo;
+        return _R;
+        }
+
+inline bool operator<(const _Uint128 & _L, const _Uint128 & _R)
+        { return _L._Hi < _R._Hi || (_L._Hi == _R._Hi && _L._Lo < _R._Lo); }
+
+#if defined(_DEC_HAS_INT128)
+// the compiler's own 128-bit integers
+__extension__ typedef unsigned __int128 _NativeUint128;
+__extension__ typedef __int128          _NativeInt128;
+#endif /* defined(_DEC_HAS_INT128) */
+
+// the full product of two 64-bit integers
+inline _Uint128 _Mul64(uint64_t _L, uint64_t _R)
+        {
+#if defined(_DEC_HAS_INT128)
+        const _NativeUint128 _P = static_cast<_NativeUint128>(_L) * _R;
+        return _MakeUint128(static_cast<uint64_t>(_P >> 64),
+                            static_cast<uint64_t>(_P));
+#else
+        const uint64_t _L0 = _L & 0xFFFFFFFFULL, _L1 = _L >> 32;
+        const uint64_t _R0 = _R & 0xFFFFFFFFULL, _R1 = _R >> 32;
+        const uint64_t _P00 = _L0 * _R0, _P01 = _L0 * _R1;
+        const uint64_t _P10 = _L1 * _R0, _P11 = _L1 * _R1;
+        const uint64_t _Mid = (_P00 >> 32) + (_P01 & 0xFFFFFFFFULL) +
+                              (_P10 & 0xFFFFFFFFULL);
+        return _MakeUint128(_P11 + (_P01 >> 32) + (_P10 >> 32) + (_Mid >> 32),
+                            (_Mid << 32) | (_P00 & 0xFFFFFFFFULL));
+#endif /* defined(_DEC_HAS_INT128) */
+        }
+
+inline _Uint128 _Add64(const _Uint128 & _L, uint64_t _R)
+        {
+        const uint64_t _Lo = _L._Lo + _R;
+        return _MakeUint128(_L._Hi + (_Lo < _R), _Lo);
+        }
+
+// divides _X by _D in place; returns the remainder
+inline uint32_t _DivSmall(_Uint128 & _X, uint32_t _D)
+        {
+        if (_X._Hi == 0)
+                {
+                const uint32_t _R = static_cast<uint32_t>(_X._Lo % _D);
+                _X._Lo /= _D;
+                return _R;
+                }
+        uint64_t _T = _X._Hi >> 32;
+        const uint64_t _Q3 = _T / _D;
+        _T = ((_T % _D) << 32) | (_X._Hi & 0xFFFFFFFFULL);
+        const uint64_t _Q2 = _T / _D;
+        _T = ((_T % _D) << 32) | (_X._Lo >> 32);
+        const uint64_t _Q1 = _T / _D;
+        _T = ((_T % _D) << 32) | (_X._Lo & 0xFFFFFFFFULL);
+        const uint64_t _Q0 = _T / _D;
+        _X = _MakeUint128((_Q3 << 32) | _Q2, (_Q1 << 32) | _Q0);
+        return static_cast<uint32_t>(_T % _D);
+        }
+
+// classes of an unpacked encoding
+enum _NativeKind {
+        _NativeFinite,
+        _NativeInf,
+        _NativeQNaN,
+        _NativeSNaN
+};
+
+// An unpacked decimal32 or decimal64 value, (-1)^_Sign * _Coeff *
+// 10^_Exp.  For a NaN, _Coeff is the payload and _Exp is zero.
+struct _Native64 {
+        unsigned    _Sign;
+        _NativeKind _Kind;
+        int         _Exp;
+        uint64_t    _Coeff;
+};
+
+// an unpacked decimal128 value, as for _Native64
+struct _Native128 {
+        unsigned    _Sign;
+        _NativeKind _Kind;
+        int         _Exp;
+        _Uint128    _Coeff;
+};
+
+// The encodings as unsigned integers in native byte order.  The
+// decimal128 word is held in memory as two 64-bit words, in the order
+// of the platform.
+inline uint32_t _GetWord(const _DecBase<_FmtTraits<decimal32> > & _V)
+        {
+        uint32_t _W;
+        memcpy(&_W, _V._GetBytes(), sizeof(_W));
+        return _W;
+        }
+
+inline uint64_t _GetWord(const _DecBase<_FmtTraits<decimal64> > & _V)
+        {
+        uint64_t _W;
+        memcpy(&_W, _V._GetBytes(), sizeof(_W));
+        return _W;
+        }
+
+inline _Uint128 _GetWord(const _DecBase<_FmtTraits<decimal128> > & _V)
+        {
+        uint64_t _W[2];
+        memcpy(_W, _V._GetBytes(), sizeof(_W));
+#if defined(_DEC_BIG_ENDIAN)
+        return _MakeUint128(_W[0], _W[1]);
+#else
+        return _MakeUint128(_W[1], _W[0]);
+#endif /* defined(_DEC_BIG_ENDIAN) */
+        }
+
+inline void _SetWord(_DecBase<_FmtTraits<decimal32> > & _V, uint32_t _W)
+        { _V._SetBytes(reinterpret_cast<const uint8_t *>(&_W)); }
+
+inline void _SetWord(_DecBase<_FmtTraits<decimal64> > & _V, uint64_t _W)
+        { _V._SetBytes(reinterpret_cast<const uint8_t *>(&_W)); }
+
+inline void _SetWord(_DecBase<_FmtTraits<decimal128> > & _V,
+                     const _Uint128 & _W)
+        {
+#if defined(_DEC_BIG_ENDIAN)
+        const uint64_t _Tmp[2] = { _W._Hi, _W._Lo };
+#else
+        const uint64_t _Tmp[2] = { _W._Lo, _W._Hi };
+#endif /* defined(_DEC_BIG_ENDIAN) */
+        _V._SetBytes(reinterpret_cast<const uint8_t *>(_Tmp));
+        }
+
+// parameters of the decimal32 and decimal64 interchange formats
+struct _Layout32 {
+        typedef uint32_t _Word;
+        static const int      _Bits = 32;
+        static const int      _ExpCont = 6;    // exponent continuation
+        static const int      _Declets = 2;
+        static const int      _Bias = 101;
+        static const uint64_t _MsdScale = 1000000ULL;
+        static const uint64_t _CoeffLimit = 10000000ULL;
+};
+
+struct _Layout64 {
+        typedef uint64_t _Word;
+        static const int      _Bits = 64;
+        static const int      _ExpCont = 8;
+        static const int      _Declets = 5;
+        static const int      _Bias = 398;
+        static const uint64_t _MsdScale = 1000000000000000ULL;
+        static const uint64_t _CoeffLimit = 10000000000000000ULL;
+};
+
+// The combination field of a finite DPD encoding holds the most
+// significant digit and the two leading bits of the biased exponent.
+inline void _DecodeComb(unsigned _Comb, unsigned & _Msd, unsigned & _ExpHi)
+        {
+        if ((_Comb >> 3) == 3)
+                {
+                _Msd = 8 + (_Comb & 1);
+                _ExpHi = (_Comb >> 1) & 3;
+                }
+        else
+                {
+                _Msd = _Comb & 7;
+                _ExpHi = _Comb >> 3;
+                }
+        }
+
+inline unsigned _EncodeComb(unsigned _Msd, unsigned _ExpHi)
+        {
+        return _Msd < 8 ? (_ExpHi << 3) | _Msd :
+                          0x18 | (_ExpHi << 1) | (_Msd & 1);
+        }
+
+// Unpacks a DPD encoding.
+template <class _L> inline
+void _UnpackDPD(typename _L::_Word _W, _Native64 & _N)
+        {
+        const int _Trail = _L::_Bits - 6 - _L::_ExpCont;
+
+        _N._Sign = static_cast<unsigned>(_W >> (_L::_Bits - 1));
+        const unsigned _Comb =
+                static_cast<unsigned>(_W >> (_L::_Bits - 6)) & 0x1F;
+
+        uint64_t _C = 0;
+        for (int _I = _L::_Declets - 1; _I >= 0; --_I)
+                {
+                _C = _C * 1000 +
+                     DPD2BIN[static_cast<unsigned>(_W >> (10 * _I)) & 0x3FF];
+                }
+
+        if (_Comb >= 0x1E)
+                {
+                _N._Exp = 0;
+                if (_Comb == 0x1E)
+                        {
+                        _N._Kind = _NativeInf;
+                        _N._Coeff = 0;
+                        }
+                else
+                        {
+                        _N._Kind = ((_W >> (_L::_Bits - 7)) & 1) ?
+                                   _NativeSNaN : _NativeQNaN;
+                        _N._Coeff = _C;
+                        }
+                return;
+                }
+
+        unsigned _Msd, _ExpHi;
+        _DecodeComb(_Comb, _Msd, _ExpHi);
+        const unsigned _ExpLo = static_cast<unsigned>(_W >> _Trail) &
+                                ((1U << _L::_ExpCont) - 1);
+
+        _N._Kind = _NativeFinite;
+        _N._Exp = static_cast<int>((_ExpHi << _L::_ExpCont) | _ExpLo) -
+                  _L::_Bias;
+        _N._Coeff = _Msd * _L::_MsdScale + _C;
+        }
+
+// Packs a DPD encoding.  _N must hold a canonical value (as produced
+// by the _Unpack functions); the exponent must be in range.
+template <class _L> inline
+typename _L::_Word _PackDPD(const _Native64 & _N)
+        {
+        typedef typename _L::_Word _Word;
+        const int _Trail = _L::_Bits - 6 - _L::_ExpCont;
+
+        _Word _W = static_cast<_Word>(_N._Sign) << (_L::_Bits - 1);
+        if (_N._Kind == _NativeInf)
+                { return _W | (static_cast<_Word>(0x1E) << (_L::_Bits - 6)); }
+
+        uint64_t _C = _N._Coeff;
+        for (int _I = 0; _I != _L::_Declets; ++_I)
+                {
+                _W |= static_cast<_Word>(BIN2DPD[_C % 1000]) << (10 * _I);
+                _C /= 1000;
+                }
+
+        if (_N._Kind != _NativeFinite)
+                {
+                _W |= static_cast<_Word>(0x1F) << (_L::_Bits - 6);
+                if (_N._Kind == _NativeSNaN)
+                        { _W |= static_cast<_Word>(1) << (_L::_Bits - 7); }
+                return _W;
+                }
+
+        const unsigned _Msd = static_cast<unsigned>(_C);
+        const unsigned _E = static_cast<unsigned>(_N._Exp + _L::_Bias);
+        const unsigned _ExpHi = _E >> _L::_ExpCont;
+        const unsigned _Comb = _EncodeComb(_Msd, _ExpHi);
+        return _W | (static_cast<_Word>(_Comb) << (_L::_Bits - 6)) |
+               (static_cast<_Word>(_E & ((1U << _L::_ExpCont) - 1)) << _Trail);
+        }
+
+// Unpacks a BID encoding.  Non-canonical coefficients and payloads
+// read as zero.
+template <class _L> inline
+void _UnpackBID(typename _L::_Word _W, _Native64 & _N)
+        {
+        typedef typename _L::_Word _Word;
+        const int _ExpBits = _L::_ExpCont + 2;
+        const int _Small = _L::_Bits - 1 - _ExpBits;    // coefficient bits
+        const int _Large = _Small - 2;
+        const unsigned _ExpMask = (1U << _ExpBits) - 1;
+
+        _N._Sign = static_cast<unsigned>(_W >> (_L::_Bits - 1));
+        if (((_W >> (_L::_Bits - 3)) & 3) != 3)
+                {
+                _N._Kind = _NativeFinite;
+                const unsigned _E =
+                        static_cast<unsigned>(_W >> _Small) & _ExpMask;
+                _N._Exp = static_cast<int>(_E) - _L::_Bias;
+                _N._Coeff = _W & ((static_cast<_Word>(1) << _Small) - 1);
+                }
+        else if (((_W >> (_L::_Bits - 5)) & 3) != 3)
+                {
+                _N._Kind = _NativeFinite;
+                const unsigned _E =
+                        static_cast<unsigned>(_W >> _Large) & _ExpMask;
+                _N._Exp = static_cast<int>(_E) - _L::_Bias;
+                _N._Coeff = (static_cast<uint64_t>(1) << _Small) |
+                            (_W & ((static_cast<_Word>(1) << _Large) - 1));
+                }
+        else
+                {
+                const int _Trail = _L::_Bits - 6 - _L::_ExpCont;
+                const unsigned _Comb =
+                        static_cast<unsigned>(_W >> (_L::_Bits - 6)) & 0x1F;
+                _N._Exp = 0;
+                if (_Comb == 0x1E)
+                        {
+                        _N._Kind = _NativeInf;
+                        _N._Coeff = 0;
+                        return;
+                        }
+                _N._Kind = ((_W >> (_L::_Bits - 7)) & 1) ?
+                           _NativeSNaN : _NativeQNaN;
+                _N._Coeff = _W & ((static_cast<_Word>(1) << _Trail) - 1);
+                if (_N._Coeff >= _L::_CoeffLimit / 10)
+                        { _N._Coeff = 0; }
+                return;
+                }
+        if (_N._Coeff >= _L::_CoeffLimit)
+                { _N._Coeff = 0; }
+        }
+
+// Packs a BID encoding, under the same conditions as _PackDPD.
+template <class _L> inline
+typename _L::_Word _PackBID(const _Native64 & _N)
+        {
+        typedef typename _L::_Word _Word;
+        const int _Small = _L::_Bits - 3 - _L::_ExpCont;
+        const int _Large = _Small - 2;
+
+        _Word _W = static_cast<_Word>(_N._Sign) << (_L::_Bits - 1);
+        const _Word _Payload = static_cast<_Word>(_N._Coeff);
+        switch (_N._Kind)
+                {
+                case _NativeInf:
+                        return _W |
+                               (static_cast<_Word>(0x1E) << (_L::_Bits - 6));
+                case _NativeQNaN:
+                        return _W |
+                               (static_cast<_Word>(0x3E) << (_L::_Bits - 7)) |
+                               _Payload;
+                case _NativeSNaN:
+                        return _W |
+                               (static_cast<_Word>(0x3F) << (_L::_Bits - 7)) |
+                               _Payload;
+                default:
+                        break;
+                }
+
+        const _Word _E = static_cast<_Word>(_N._Exp + _L::_Bias);
+        if ((_N._Coeff >> _Small) == 0)
+                { return _W | (_E << _Small) | static_cast<_Word>(_N._Coeff); }
+        return _W | (static_cast<_Word>(3) << (_L::_Bits - 3)) |
+               (_E << _Large) |
+               (static_cast<_Word>(_N._Coeff) &
+                ((static_cast<_Word>(1) << _Large) - 1));
+        }
+
+// the declet at position _I (0 is the least significant) of a
+// decimal128 word
+inline unsigned _Declet128(const _Uint128 & _W, int _I)
+        {
+        const int _Bit = 10 * _I;
+        if (_Bit >= 64)
+                {
+                return static_cast<unsigned>(_W._Hi >> (_Bit - 64)) &
+                       0x3FF;
+                }
+        if (_Bit <= 54)
+                { return static_cast<unsigned>(_W._Lo >> _Bit) & 0x3FF; }
+        return static_cast<unsigned>((_W._Lo >> _Bit) |
+                                     (_W._Hi << (64 - _Bit))) & 0x3FF;
+        }
+
+// ORs declet _D into position _I of a decimal128 word
+inline void _OrDeclet128(_Uint128 & _W, int _I, unsigned _D)
+        {
+        const int _Bit = 10 * _I;
+        if (_Bit >= 64)
+                { _W._Hi |= static_cast<uint64_t>(_D) << (_Bit - 64); }
+        else
+                {
+                _W._Lo |= static_cast<uint64_t>(_D) << _Bit;
+                if (_Bit > 54)
+                        { _W._Hi |= static_cast<uint64_t>(_D) >> (64 - _Bit); }
+                }
+        }
+
+// the trailing 110 bits of a decimal128 encoding, holding the declets
+// of _C below 10^33
+inline _Uint128 _Declets128(_Uint128 _C)
+        {
+        _Uint128 _T = _MakeUint128(0, 0);
+        for (int _I = 0; _I < 11; _I += 3)
+                {
+                uint32_t _R = _DivSmall(_C, 1000000000U);
+                for (int _J = _I; _J != _I + 3 && _J != 11; ++_J)
+                        {
+                        _OrDeclet128(_T, _J, BIN2DPD[_R % 1000]);
+                        _R /= 1000;
+                        }
+                }
+        return _T;
+        }
+
+// the value of the 11 declets in the trailing bits of _W
+inline _Uint128 _FromDeclets128(const _Uint128 & _W)
+        {
+        uint64_t _Hi = 0, _Lo = 0;
+        for (int _I = 10; _I >= 6; --_I)
+                { _Hi = _Hi * 1000 + DPD2BIN[_Declet128(_W, _I)]; }
+        for (int _I = 5; _I >= 0; --_I)
+                { _Lo = _Lo * 1000 + DPD2BIN[_Declet128(_W, _I)]; }
+        return _Add64(_Mul64(_Hi, 1000000000000000000ULL), _Lo);
+        }
+
+// 10^33 and 10^34
+inline _Uint128 _Pow10_33()
+        { return _MakeUint128(0x314DC6448D93ULL, 0x38C15B0A00000000ULL); }
+
+inline _Uint128 _Pow10_34()
+        { return _MakeUint128(0x1ED09BEAD87C0ULL, 0x378D8E6400000000ULL); }
+
+inline void _UnpackDPD128(const _Uint128 & _W, _Native128 & _N)
+        {
+        const unsigned _Comb = static_cast<unsigned>(_W._Hi >> 58) & 0x1F;
+        _N._Sign = static_cast<unsigned>(_W._Hi >> 63);
+        _N._Coeff = _FromDeclets128(_W);
+
+        if (_Comb >= 0x1E)
+                {
+                _N._Exp = 0;
+                if (_Comb == 0x1E)
+                        {
+                        _N._Kind = _NativeInf;
+                        _N._Coeff = _MakeUint128(0, 0);
+                        }
+                else
+                        {
+                        _N._Kind = ((_W._Hi >> 57) & 1) ?
+                                   _NativeSNaN : _NativeQNaN;
+                        }
+                return;
+                }
+
+        unsigned _Msd, _ExpHi;
+        _DecodeComb(_Comb, _Msd, _ExpHi);
+        const unsigned _ExpLo = static_cast<unsigned>(_W._Hi >> 46) & 0xFFF;
+
+        _N._Kind = _NativeFinite;
+        _N._Exp = static_cast<int>((_ExpHi << 12) | _ExpLo) - 6176;
+        if (_Msd != 0)
+                {
+                const _Uint128 _P = _Pow10_33();
+                const _Uint128 _M = _MakeUint128(_P._Hi * _Msd, 0);
+                const _Uint128 _L = _Mul64(_P._Lo, _Msd);
+                _N._Coeff = _MakeUint128(_N._Coeff._Hi + _M._Hi + _L._Hi,
+                                         _N._Coeff._Lo);
+                _N._Coeff = _Add64(_N._Coeff, _L._Lo);
+                }
+        }
+
+inline _Uint128 _PackDPD128(const _Native128 & _N)
+        {
+        _Uint128 _W = _MakeUint128(static_cast<uint64_t>(_N._Sign) << 63, 0);
+        if (_N._Kind == _NativeInf)
+                {
+                _W._Hi |= 0x1EULL << 58;
+                return _W;
+                }
+
+        // split off the most significant digit
+        _Uint128 _C = _N._Coeff;
+        unsigned _Msd = 0;
+        const _Uint128 _P = _Pow10_33();
+        while (!(_C < _P))
+                {
+                _C._Hi -= _P._Hi + (_C._Lo < _P._Lo);
+                _C._Lo -= _P._Lo;
+                ++_Msd;
+                }
+        const _Uint128 _T = _Declets128(_C);
+        _W._Hi |= _T._Hi;
+        _W._Lo = _T._Lo;
+
+        if (_N._Kind != _NativeFinite)
+                {
+                _W._Hi |= 0x1FULL << 58;
+                if (_N._Kind == _NativeSNaN)
+                        { _W._Hi |= 1ULL << 57; }
+                return _W;
+                }
+
+        const unsigned _E = static_cast<unsigned>(_N._Exp + 6176);
+        const unsigned _ExpHi = _E >> 12;
+        const unsigned _Comb = _EncodeComb(_Msd, _ExpHi);
+        _W._Hi |= (static_cast<uint64_t>(_Comb) << 58) |
+                  (static_cast<uint64_t>(_E & 0xFFF) << 46);
+        return _W;
+        }
+
+inline void _UnpackBID128(const _Uint128 & _W, _Native128 & _N)
+        {
+        _N._Sign = static_cast<unsigned>(_W._Hi >> 63);
+        if (((_W._Hi >> 61) & 3) != 3)
+                {
+                _N._Kind = _NativeFinite;
+                _N._Exp = static_cast<int>((_W._Hi >> 49) & 0x3FFF) - 6176;
+                _N._Coeff = _MakeUint128(_W._Hi & ((1ULL << 49) - 1), _W._Lo);
+                if (!(_N._Coeff < _Pow10_34()))
+                        { _N._Coeff = _MakeUint128(0, 0); }
+                }
+        else if (((_W._Hi >> 59) & 3) != 3)
+                {
+                // the coefficient is at least 2^113, which exceeds 10^34
+                _N._Kind = _NativeFinite;
+                _N._Exp = static_cast<int>((_W._Hi >> 47) & 0x3FFF) - 6176;
+                _N._Coeff = _MakeUint128(0, 0);
+                }
+        else
+                {
+                const unsigned _Comb =
+                        static_cast<unsigned>(_W._Hi >> 58) & 0x1F;
+                _N._Exp = 0;
+                if (_Comb == 0x1E)
+                        {
+                        _N._Kind = _NativeInf;
+                        _N._Coeff = _MakeUint128(0, 0);
+                        return;
+                        }
+                _N._Kind = ((_W._Hi >> 57) & 1) ? _NativeSNaN : _NativeQNaN;
+                _N._Coeff = _MakeUint128(_W._Hi & ((1ULL << 46) - 1), _W._Lo);
+                if (!(_N._Coeff < _Pow10_33()))
+                        { _N._Coeff = _MakeUint128(0, 0); }
+                }
+        }
+
+inline _Uint128 _PackBID128(const _Native128 & _N)
+        {
+        _Uint128 _W = _N._Coeff;
+        _W._Hi |= static_cast<uint64_t>(_N._Sign) << 63;
+        switch (_N._Kind)
+                {
+                case _NativeInf:
+                        return _MakeUint128((_W._Hi & (1ULL << 63)) |
+                                            (0x1EULL << 58), 0);
+                case _NativeQNaN:
+                        _W._Hi |= 0x3EULL << 57;
+                        return _W;
+                case _NativeSNaN:
+                        _W._Hi |= 0x3FULL << 57;
+                        return _W;
+                default:
+                        break;
+                }
+        _W._Hi |= static_cast<uint64_t>(_N._Exp + 6176) << 49;
+        return _W;
+        }
+
+// Is a coefficient whose last kept digit is _Last rounded away from
+// zero, when the first digit dropped is _First and _Sticky is set if
+// any later one is nonzero?
+inline bool _RoundsUp(rounding _Mode, unsigned _Sign, unsigned _Last,
+                      unsigned _First, bool _Sticky)
+        {
+        const bool _Inexact = _First != 0 || _Sticky;
+        switch (_Mode)
+                {
+                case DEC_ROUND_CEILING:
+                        return _Inexact && !_Sign;
+                case DEC_ROUND_FLOOR:
+                        return _Inexact && _Sign;
+                case DEC_ROUND_UP:
+                        return _Inexact;
+                case DEC_ROUND_DOWN:
+                        return false;
+                case DEC_ROUND_05UP:
+                        return _Inexact && (_Last == 0 || _Last == 5);
+                case DEC_ROUND_HALF_UP:
+                        return _First >= 5;
+                case DEC_ROUND_HALF_DOWN:
+                        return _First > 5 || (_First == 5 && _Sticky);
+                case DEC_ROUND_HALF_EVEN:
+                default:
+                        return _First > 5 ||
+                               (_First == 5 && (_Sticky || (_Last & 1)));
+                }
+        }
+
+// Unpack and pack the decimal types, in whichever encoding they are
+// stored (see _DEC_DECIMAL64_BID).
+inline void _Unpack(const _DecBase<_FmtTraits<decimal32> > & _V,
+                    _Native64 & _N)
+        { _UnpackDPD<_Layout32>(_GetWord(_V), _N); }
+
+inline void _Unpack(const _DecBase<_FmtTraits<decimal64> > & _V,
+                    _Native64 & _N)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _UnpackBID<_Layout64>(_GetWord(_V), _N);
+#else
+        _UnpackDPD<_Layout64>(_GetWord(_V), _N);
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+inline void _Unpack(const _DecBase<_FmtTraits<decimal128> > & _V,
+                    _Native128 & _N)
+        { _UnpackDPD128(_GetWord(_V), _N); }
+
+inline void _Pack(_DecBase<_FmtTraits<decimal32> > & _V,
+                  const _Native64 & _N)
+        { _SetWord(_V, _PackDPD<_Layout32>(_N)); }
+
+inline void _Pack(_DecBase<_FmtTraits<decimal64> > & _V,
+                  const _Native64 & _N)
+        {
+#if defined(_DEC_DECIMAL64_BID)
+        _SetWord(_V, _PackBID<_Layout64>(_N));
+#else
+        _SetWord(_V, _PackDPD<_Layout64>(_N));
+#endif /* defined(_DEC_DECIMAL64_BID) */
+        }
+
+inline void _Pack(_DecBase<_FmtTraits<decimal128> > & _V,
+                  const _Native128 & _N)
+        { _SetWord(_V, _PackDPD128(_N)); }
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECNATIVE_H */
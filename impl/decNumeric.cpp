@@ -0,0 +1,645 @@
+/* ------------------------------------------------------------------ */
+/* decNumeric.cpp source file                                         */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <climits>
+#include <cstring>
+#include <vector>
+
+#include "decnumeric"
+#include "cdecmath"
+#include "impl/decKernel.h"
+#include "impl/decThread.h"
+
+namespace std {
+namespace decimal {
+
+static const uint32_t _LimbBase = 1000000000;
+
+static const uint32_t _LimbPow10[9] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+void decimal_accumulator::clear()
+        {
+        _Lo = 0;
+        _Hi = 0;
+        _MinExp = INT_MAX;
+        _Signs = 0;
+        _Specials = 0;
+        }
+
+// Widens the limbs in use to include [_From, _To), clearing those
+// newly taken into use.
+void decimal_accumulator::_Cover(int _From, int _To)
+        {
+        if (_Lo == _Hi)
+                { _Lo = _Hi = _From; }
+        if (_From < _Lo)
+                {
+                for (unsigned _S = 0; _S != 2; ++_S)
+                        { memset(&_Mag[_S][_From], 0, (_Lo - _From) * 4); }
+                _Lo = _From;
+                }
+        if (_To > _Hi)
+                {
+                for (unsigned _S = 0; _S != 2; ++_S)
+                        { memset(&_Mag[_S][_Hi], 0, (_To - _Hi) * 4); }
+                _Hi = _To;
+                }
+        }
+
+// Adds _Coeff[0] + _Coeff[1] * 10^9 + ..., times 10^_Exp, to the
+// magnitude of sign _Sign.
+void decimal_accumulator::_AddCoeff(unsigned _Sign, int _Exp,
+                                    const uint32_t * _Coeff, int _Count)
+        {
+        if (_Exp < _MinExp)
+                { _MinExp = _Exp; }
+        _Signs |= 1U << _Sign;
+
+        const int _Pos = _Exp - _Bias;
+        int _I = _Pos / 9;
+        const uint64_t _Scale = _LimbPow10[_Pos % 9];
+        uint32_t * const _M = _Mag[_Sign];
+        _Cover(_I, _I + _Count + 1);
+
+        uint64_t _Carry = 0;
+        for (int _K = 0; _K != _Count; ++_K, ++_I)
+                {
+                const uint64_t _V = _Coeff[_K] * _Scale + _Carry + _M[_I];
+                _M[_I] = static_cast<uint32_t>(_V % _LimbBase);
+                _Carry = _V / _LimbBase;
+                }
+        for (; _Carry != 0; ++_I)
+                {
+                if (_I == _Hi)
+                        { _Cover(_I, _I + 1); }
+                const uint64_t _V = _Carry + _M[_I];
+                _M[_I] = static_cast<uint32_t>(_V % _LimbBase);
+                _Carry = _V / _LimbBase;
+                }
+        }
+
+// Splits _C into base 10^9 limbs.
+static void _Split(uint64_t _C, uint32_t * _L)
+        {
+        _L[0] = static_cast<uint32_t>(_C % _LimbBase);
+        _L[1] = static_cast<uint32_t>(_C / _LimbBase);
+        }
+
+static void _Split(_Uint128 _C, uint32_t * _L)
+        {
+        for (int _K = 0; _K != 4; ++_K)
+                { _L[_K] = _DivSmall(_C, _LimbBase); }
+        }
+
+static bool _IsZero(uint64_t _C)
+        { return _C == 0; }
+
+static bool _IsZero(const _Uint128 & _C)
+        { return _C._Hi == 0 && _C._Lo == 0; }
+
+// Multiplies the _N limbs of _X and _Y into the 2 * _N limbs of _P,
+// a column at a time.
+static void _MulLimbs(const uint32_t * _X, const uint32_t * _Y, int _N,
+                      uint32_t * _P)
+        {
+        uint64_t _Carry = 0;
+        for (int _K = 0; _K != 2 * _N - 1; ++_K)
+                {
+                uint64_t _Col = _Carry;
+                _Carry = 0;
+                for (int _I = _K < _N ? 0 : _K - _N + 1; _I <= _K && _I < _N;
+                     ++_I)
+                        {
+                        const uint64_t _T = static_cast<uint64_t>(_X[_I]) *
+                                            _Y[_K - _I];
+                        _Col += _T % _LimbBase;
+                        _Carry += _T / _LimbBase;
+                        }
+                _P[_K] = static_cast<uint32_t>(_Col % _LimbBase);
+                _Carry += _Col / _LimbBase;
+                }
+        _P[2 * _N - 1] = static_cast<uint32_t>(_Carry);
+        }
+
+void decimal_accumulator::_Add(const decimal64 & _X, unsigned _Neg)
+        {
+        _Native64 _N;
+        _Unpack(_X, _N);
+        switch (_N._Kind)
+                {
+                case _NativeFinite:
+                        {
+                        uint32_t _C[2];
+                        _Split(_N._Coeff, _C);
+                        _AddCoeff(_N._Sign ^ _Neg, _N._Exp, _C, 2);
+                        break;
+                        }
+                case _NativeInf:
+                        _Specials |= _N._Sign ^ _Neg ? _NegInf : _PosInf;
+                        break;
+                case _NativeQNaN:
+                        _Specials |= _QNaN;
+                        break;
+                case _NativeSNaN:
+                        _Specials |= _Invalid;
+                        break;
+                }
+        }
+
+void decimal_accumulator::_Add(const decimal128 & _X, unsigned _Neg)
+        {
+        _Native128 _N;
+        _Unpack(_X, _N);
+        switch (_N._Kind)
+                {
+                case _NativeFinite:
+                        {
+                        uint32_t _C[4];
+                        _Split(_N._Coeff, _C);
+                        _AddCoeff(_N._Sign ^ _Neg, _N._Exp, _C, 4);
+                        break;
+                        }
+                case _NativeInf:
+                        _Specials |= _N._Sign ^ _Neg ? _NegInf : _PosInf;
+                        break;
+                case _NativeQNaN:
+                        _Specials |= _QNaN;
+                        break;
+                case _NativeSNaN:
+                        _Specials |= _Invalid;
+                        break;
+                }
+        }
+
+template <class _Native>
+void decimal_accumulator::_AddProduct(const _Native & _X, const _Native & _Y)
+        {
+        const unsigned _Sign = _X._Sign ^ _Y._Sign;
+        if (_X._Kind == _NativeFinite && _Y._Kind == _NativeFinite)
+                {
+                // two limbs for a decimal64 coefficient, four for a
+                // decimal128 one
+                enum { _N = sizeof _X._Coeff / 4 };
+                uint32_t _L[_N], _R[_N], _P[2 * _N];
+                _Split(_X._Coeff, _L);
+                _Split(_Y._Coeff, _R);
+                _MulLimbs(_L, _R, _N, _P);
+                _AddCoeff(_Sign, _X._Exp + _Y._Exp, _P, 2 * _N);
+                }
+        else if (_X._Kind == _NativeSNaN || _Y._Kind == _NativeSNaN)
+                { _Specials |= _Invalid; }
+        else if (_X._Kind == _NativeQNaN || _Y._Kind == _NativeQNaN)
+                { _Specials |= _QNaN; }
+        else if ((_X._Kind == _NativeFinite && _IsZero(_X._Coeff)) ||
+                 (_Y._Kind == _NativeFinite && _IsZero(_Y._Coeff)))
+                { _Specials |= _Invalid; }
+        else
+                { _Specials |= _Sign ? _NegInf : _PosInf; }
+        }
+
+void decimal_accumulator::add_product(decimal64 _X, decimal64 _Y)
+        {
+        _Native64 _L, _R;
+        _Unpack(_X, _L);
+        _Unpack(_Y, _R);
+        _AddProduct(_L, _R);
+        }
+
+void decimal_accumulator::add_product(decimal128 _X, decimal128 _Y)
+        {
+        _Native128 _L, _R;
+        _Unpack(_X, _L);
+        _Unpack(_Y, _R);
+        _AddProduct(_L, _R);
+        }
+
+decimal_accumulator &
+decimal_accumulator::operator+=(const decimal_accumulator & _Other)
+        {
+        if (_Other._Lo != _Other._Hi)
+                { _Cover(_Other._Lo, _Other._Hi); }
+        for (unsigned _S = 0; _S != 2; ++_S)
+                {
+                uint32_t * const _M = _Mag[_S];
+                const uint32_t * const _O = _Other._Mag[_S];
+                uint32_t _Carry = 0;
+                for (int _I = _Other._Lo; _I < _Other._Hi || _Carry != 0; ++_I)
+                        {
+                        if (_I == _Hi)
+                                { _Cover(_I, _I + 1); }
+                        const uint32_t _Term = _I < _Other._Hi ? _O[_I] : 0;
+                        const uint32_t _V = _M[_I] + _Term + _Carry;
+                        _Carry = _V >= _LimbBase;
+                        _M[_I] = _Carry ? _V - _LimbBase : _V;
+                        }
+                }
+        if (_Other._MinExp < _MinExp)
+                { _MinExp = _Other._MinExp; }
+        _Signs |= _Other._Signs;
+        _Specials |= _Other._Specials;
+        return *this;
+        }
+
+// Returns the number of digits written to _Bcd, zero if the sum is
+// zero.  The digits beyond the first _Max are dropped, and the last
+// digit kept is made odd if any of them is not zero; that leaves the
+// rounding of the sum to _Max - 2 or fewer digits unchanged.
+int decimal_accumulator::_Digits(uint8_t * _Bcd, int _Max, int & _Exp,
+                                 unsigned & _Sign) const
+        {
+        // the larger magnitude, less the smaller
+        int _I = _Hi;
+        while (_I > _Lo && _Mag[0][_I - 1] == _Mag[1][_I - 1])
+                { --_I; }
+        if (_I <= _Lo)
+                { return 0; }
+        _Sign = _Mag[0][_I - 1] < _Mag[1][_I - 1];
+        const uint32_t * const _L = _Mag[_Sign];
+        const uint32_t * const _R = _Mag[1 - _Sign];
+
+        uint32_t _Diff[_Limbs];
+        uint32_t _Borrow = 0;
+        int _Top = _Lo;
+        for (int _K = _Lo; _K != _I; ++_K)
+                {
+                const uint32_t _Sub = _R[_K] + _Borrow;
+                _Borrow = _L[_K] < _Sub;
+                _Diff[_K] = _Borrow ? _L[_K] + _LimbBase - _Sub :
+                                      _L[_K] - _Sub;
+                if (_Diff[_K] != 0)
+                        { _Top = _K; }
+                }
+
+        // the position of the first digit, counted from _Bias
+        int _First = 9 * _Top + 8;
+        while (_Diff[_Top] < _LimbPow10[_First % 9])
+                { --_First; }
+
+        // every digit below _MinExp is zero
+        const int _Bottom = _MinExp - _Bias;
+        int _Last = _First - _Max + 1;
+        if (_Last < _Bottom)
+                { _Last = _Bottom; }
+
+        int _N = 0;
+        for (int _P = _First; _P >= _Last; --_P)
+                { _Bcd[_N++] = _Diff[_P / 9] / _LimbPow10[_P % 9] % 10; }
+
+        if (_Last > _Bottom)
+                {
+                bool _Sticky = _Diff[_Last / 9] % _LimbPow10[_Last % 9] != 0;
+                for (int _K = _Last / 9 - 1; !_Sticky && _K >= _Lo; --_K)
+                        { _Sticky = _Diff[_K] != 0; }
+                if (_Sticky)
+                        { _Bcd[_N - 1] |= 1; }
+                }
+        _Exp = _Last + _Bias;
+        return _N;
+        }
+
+// Divides the digits of the sum, one at a time.  The remainder stays
+// below _Divisor, so ten times it plus a digit fits 64 bits; the
+// quotient is exact up to the digits dropped after the first _Max,
+// which make the last digit kept odd as in _Digits.
+int decimal_accumulator::_Quotient(uint8_t * _Bcd, int _Max,
+                                   uint64_t _Divisor, int & _Exp,
+                                   unsigned & _Sign) const
+        {
+        uint8_t _Sum[9 * _Limbs];
+        int _SumExp;
+        const int _N = _Digits(_Sum, 9 * _Limbs, _SumExp, _Sign);
+        if (_N == 0)
+                { return 0; }
+
+        uint64_t _R = 0;
+        int _Count = 0;
+        int _I = 0;
+        for (; _Count != _Max && (_I < _N || _R != 0); ++_I)
+                {
+                _R = _R * 10 + (_I < _N ? _Sum[_I] : 0);
+                const uint8_t _Q = static_cast<uint8_t>(_R / _Divisor);
+                _R %= _Divisor;
+                if (_Q != 0 || _Count != 0)
+                        { _Bcd[_Count++] = _Q; }
+                }
+
+        bool _Sticky = _R != 0;
+        for (int _K = _I; !_Sticky && _K < _N; ++_K)
+                { _Sticky = _Sum[_K] != 0; }
+        if (_Sticky)
+                { _Bcd[_Count - 1] |= 1; }
+        _Exp = _SumExp + _N - _I;
+        return _Count;
+        }
+
+template <class _Tr>
+typename _Tr::_Fmt decimal_accumulator::_Result(int _Prec,
+                                                uint64_t _Divisor) const
+        {
+        typename _Tr::_Context _Ctxt;
+        typename _Tr::_Fmt _Res;
+        _DecNumber _Tmp;
+        decNumberZero(&_Tmp);
+
+        const unsigned _Inf = _Specials & (_PosInf | _NegInf);
+        if (_Divisor == 0)
+                {
+                _Tmp.bits = DECNAN;
+                _Ctxt.status |= DEC_Division_undefined;
+                }
+        else if ((_Specials & (_QNaN | _Invalid)) != 0 ||
+                 _Inf == (_PosInf | _NegInf))
+                {
+                _Tmp.bits = DECNAN;
+                if ((_Specials & _Invalid) != 0 || _Inf == (_PosInf | _NegInf))
+                        { _Ctxt.status |= DEC_Invalid_operation; }
+                }
+        else if (_Inf != 0)
+                { _Tmp.bits = DECINF | (_Inf == _NegInf ? DECNEG : 0); }
+        else
+                {
+                uint8_t _Bcd[DECNUMDIGITS];
+                int _Exp;
+                unsigned _Sign;
+                const int _N = _Divisor == 1 ?
+                        _Digits(_Bcd, _Prec + 2, _Exp, _Sign) :
+                        _Quotient(_Bcd, _Prec + 2, _Divisor, _Exp, _Sign);
+                if (_N != 0)
+                        {
+                        _Tmp.digits = _N;
+                        decNumberSetBCD(&_Tmp, _Bcd, _N);
+                        _Tmp.exponent = _Exp;
+                        _Tmp.bits = _Sign ? DECNEG : 0;
+                        }
+                else
+                        {
+                        // an exact zero
+                        _Tmp.exponent = _MinExp == INT_MAX ? 0 : _MinExp;
+                        if (_Signs == 2 ||
+                            (_Signs == 3 && _Ctxt.round == DEC_ROUND_FLOOR))
+                                { _Tmp.bits = DECNEG; }
+                        }
+                }
+        _Tr::_FromNumber(&_Res, _Tmp, &_Ctxt);
+        return _Res;
+        }
+
+decimal64 decimal_accumulator::to_decimal64() const
+        { return _Result<_FmtTraits<decimal64> >(16, 1); }
+
+decimal128 decimal_accumulator::to_decimal128() const
+        { return _Result<_FmtTraits<decimal128> >(34, 1); }
+
+decimal64 decimal_accumulator::to_decimal64(uint64_t _Divisor) const
+        { return _Result<_FmtTraits<decimal64> >(16, _Divisor); }
+
+decimal128 decimal_accumulator::to_decimal128(uint64_t _Divisor) const
+        { return _Result<_FmtTraits<decimal128> >(34, _Divisor); }
+
+decimal64 dot(const decimal64 * _X, const decimal64 * _Y, std::size_t _Count)
+        {
+        decimal_accumulator _Acc;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Acc.add_product(_X[_I], _Y[_I]); }
+        return _Acc.to_decimal64();
+        }
+
+decimal128 dot(const decimal128 * _X, const decimal128 * _Y,
+               std::size_t _Count)
+        {
+        decimal_accumulator _Acc;
+        for (std::size_t _I = 0; _I != _Count; ++_I)
+                { _Acc.add_product(_X[_I], _Y[_I]); }
+        return _Acc.to_decimal128();
+        }
+
+// chunks hold at least this many values, so that small arrays are not
+// split into more pieces than is worthwhile
+static const std::size_t _MinChunk = 1UL << 16;
+
+// chunks per thread, so that uneven progress balances out
+static const std::size_t _ChunksPerThread = 4;
+
+// the number of chunks to split _Count values into, at least one
+static std::size_t _ChunkCount(std::size_t _Count, unsigned _Threads)
+        {
+        std::size_t _Chunks = _ThreadCount(_Threads) * _ChunksPerThread;
+        if (_Chunks > _Count / _MinChunk)
+                { _Chunks = _Count / _MinChunk; }
+        return _Chunks == 0 ? 1 : _Chunks;
+        }
+
+// arguments of _SumChunk; chunk _I holds values [_I * _Chunk,
+// (_I + 1) * _Chunk)
+template <class _Dec>
+struct _SumArgs {
+        const _Dec *          _X;
+        std::size_t           _Count;
+        std::size_t           _Chunk;
+        decimal_accumulator * _Acc;
+};
+
+template <class _Dec>
+static void _SumChunk(void * _Arg, std::size_t _I)
+        {
+        const _SumArgs<_Dec> * _A = static_cast<_SumArgs<_Dec> *>(_Arg);
+        const std::size_t _Beg = _I * _A->_Chunk;
+        const std::size_t _End = _A->_Count - _Beg < _A->_Chunk ?
+                                 _A->_Count : _Beg + _A->_Chunk;
+        decimal_accumulator & _Acc = _A->_Acc[_I];
+        for (std::size_t _J = _Beg; _J < _End; ++_J)
+                { _Acc += _A->_X[_J]; }
+        }
+
+// Adds the values to _Acc, one accumulator per chunk.  The sums are
+// exact, so merging them in any order gives the same result.
+template <class _Dec>
+static void _SumValues(const _Dec * _X, std::size_t _Count,
+                       unsigned _Threads, decimal_accumulator & _Acc)
+        {
+        const std::size_t _Chunks = _ChunkCount(_Count, _Threads);
+        std::vector<decimal_accumulator> _Part(_Chunks);
+        _SumArgs<_Dec> _A;
+        _A._X = _X;
+        _A._Count = _Count;
+        _A._Chunk = (_Count + _Chunks - 1) / _Chunks;
+        _A._Acc = &_Part[0];
+        _ParallelFor(_Chunks, _SumChunk<_Dec>, &_A, _Threads);
+        for (std::size_t _I = 0; _I != _Chunks; ++_I)
+                { _Acc += _Part[_I]; }
+        }
+
+decimal64 reduce_sum(const decimal64 * _X, std::size_t _Count,
+                     unsigned _Threads)
+        {
+        decimal_accumulator _Acc;
+        _SumValues(_X, _Count, _Threads, _Acc);
+        return _Acc.to_decimal64();
+        }
+
+decimal128 reduce_sum(const decimal128 * _X, std::size_t _Count,
+                      unsigned _Threads)
+        {
+        decimal_accumulator _Acc;
+        _SumValues(_X, _Count, _Threads, _Acc);
+        return _Acc.to_decimal128();
+        }
+
+decimal64 mean(const decimal64 * _X, std::size_t _Count, unsigned _Threads)
+        {
+        decimal_accumulator _Acc;
+        _SumValues(_X, _Count, _Threads, _Acc);
+        return _Acc.to_decimal64(_Count);
+        }
+
+decimal128 mean(const decimal128 * _X, std::size_t _Count,
+                unsigned _Threads)
+        {
+        decimal_accumulator _Acc;
+        _SumValues(_X, _Count, _Threads, _Acc);
+        return _Acc.to_decimal128(_Count);
+        }
+
+// no such value
+static const std::size_t _NoValue = ~static_cast<std::size_t>(0);
+
+// the outcome of a chunk: the value kept of those not NaNs, the first
+// quiet NaN and the first signaling NaN, each as _NoValue if none
+struct _ExtremeResult {
+        std::size_t _Best;
+        std::size_t _QNaN;
+        std::size_t _SNaN;
+};
+
+// arguments of _ExtremeChunk, with chunks as for _SumArgs; _Dir is 1
+// for the maximum and -1 for the minimum
+template <class _Dec>
+struct _ExtremeArgs {
+        const _Dec *     _X;
+        std::size_t      _Count;
+        std::size_t      _Chunk;
+        int              _Dir;
+        _ExtremeResult * _Res;
+};
+
+template <class _Dec>
+static void _ExtremeChunk(void * _Arg, std::size_t _I)
+        {
+        const _ExtremeArgs<_Dec> * _A =
+                static_cast<_ExtremeArgs<_Dec> *>(_Arg);
+        const std::size_t _Beg = _I * _A->_Chunk;
+        const std::size_t _End = _A->_Count - _Beg < _A->_Chunk ?
+                                 _A->_Count : _Beg + _A->_Chunk;
+        _ExtremeResult & _R = _A->_Res[_I];
+        _R._Best = _R._QNaN = _R._SNaN = _NoValue;
+
+        typedef _KernelFmt<_Dec> _M;
+        typename _M::_Native _Best = typename _M::_Native(), _N;
+        for (std::size_t _J = _Beg; _J < _End; ++_J)
+                {
+                _Unpack(_A->_X[_J], _N);
+                if (_N._Kind == _NativeSNaN)
+                        {
+                        // the result is a NaN, whatever the other values
+                        _R._SNaN = _J;
+                        return;
+                        }
+                if (_N._Kind == _NativeQNaN)
+                        {
+                        if (_R._QNaN == _NoValue)
+                                { _R._QNaN = _J; }
+                        }
+                else if (_R._Best == _NoValue ||
+                         _KernelOrder<_M>(_N, _Best) == _A->_Dir)
+                        {
+                        _Best = _N;
+                        _R._Best = _J;
+                        }
+                }
+        }
+
+// the minimum (_Dir -1) or the maximum (_Dir 1) of the values
+template <class _Dec>
+static _Dec _Extreme(const _Dec * _X, std::size_t _Count, unsigned _Threads,
+                     int _Dir)
+        {
+        const std::size_t _Chunks = _ChunkCount(_Count, _Threads);
+        std::vector<_ExtremeResult> _Res(_Chunks);
+        _ExtremeArgs<_Dec> _A;
+        _A._X = _X;
+        _A._Count = _Count;
+        _A._Chunk = (_Count + _Chunks - 1) / _Chunks;
+        _A._Dir = _Dir;
+        _A._Res = &_Res[0];
+        _ParallelFor(_Chunks, _ExtremeChunk<_Dec>, &_A, _Threads);
+
+        typedef _KernelFmt<_Dec> _M;
+        std::size_t _Best = _NoValue, _QNaN = _NoValue;
+        typename _M::_Native _B, _N;
+        for (std::size_t _I = 0; _I != _Chunks; ++_I)
+                {
+                const _ExtremeResult & _R = _Res[_I];
+                if (_R._SNaN != _NoValue)
+                        {
+                        // quieted, and the operation signaled, by fmin
+                        // or fmax
+                        const _Dec _S = _X[_R._SNaN];
+                        return _Dir > 0 ? fmax(_S, _S) : fmin(_S, _S);
+                        }
+                if (_QNaN == _NoValue)
+                        { _QNaN = _R._QNaN; }
+                if (_R._Best == _NoValue)
+                        { continue; }
+                _Unpack(_X[_R._Best], _N);
+                if (_Best == _NoValue || _KernelOrder<_M>(_N, _B) == _Dir)
+                        {
+                        _B = _N;
+                        _Best = _R._Best;
+                        }
+                }
+
+        _Dec _V;
+        if (_Best != _NoValue)
+                { _Pack(_V, _B); }
+        else if (_QNaN != _NoValue)
+                {
+                const _Dec _Q = _X[_QNaN];
+                _V = _Dir > 0 ? fmax(_Q, _Q) : fmin(_Q, _Q);
+                }
+        else
+                { _V = _Dec::_GetNAN(); }
+        return _V;
+        }
+
+decimal64 reduce_min(const decimal64 * _X, std::size_t _Count,
+                     unsigned _Threads)
+        { return _Extreme(_X, _Count, _Threads, -1); }
+
+decimal128 reduce_min(const decimal128 * _X, std::size_t _Count,
+                      unsigned _Threads)
+        { return _Extreme(_X, _Count, _Threads, -1); }
+
+decimal64 reduce_max(const decimal64 * _X, std::size_t _Count,
+                     unsigned _Threads)
+        { return _Extreme(_X, _Count, _Threads, 1); }
+
+decimal128 reduce_max(const decimal128 * _X, std::size_t _Count,
+                      unsigned _Threads)
+        { return _Extreme(_X, _Count, _Threads, 1); }
+
+} // namespace decimal
+} // namespace std
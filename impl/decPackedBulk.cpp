@@ -0,0 +1,213 @@
+/* ------------------------------------------------------------------ */
+/* decPackedBulk.cpp source file                                      */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <cstring>
+
+#include "decpacked"
+#include "impl/decBCD.h"
+#include "impl/decSimd.h"
+
+extern "C" {
+#include "decPacked.h"
+}
+
+namespace std {
+namespace decimal {
+
+// longest field: its 43 digits still fit in a _DecNumber
+static const std::size_t _MaxPackedLength = 22;
+
+// Writes the _NG groups of _G, shifted left by _Shift digits, to a
+// packed field.  The caller ensures that the digits fit.
+static void _WritePacked(uint8_t * _F, std::size_t _Length, unsigned _SignN,
+                         std::size_t _Shift, const unsigned * _G, int _NG)
+        {
+        memset(_F, 0, _Length);
+        _F[_Length - 1] = static_cast<uint8_t>(_SignN);
+        for (int _K = 0; _K != _NG; ++_K)
+                {
+                unsigned _B = _G[_K];
+                for (std::size_t _J = _Shift + 3 * _K; _B != 0; ++_J, _B >>= 4)
+                        {
+                        const unsigned _D = _B & 0xF;
+                        _F[_Length - 1 - (_J + 1) / 2] |=
+                                static_cast<uint8_t>((_J & 1) ? _D : _D << 4);
+                        }
+                }
+        }
+
+static void _WritePackedZero(uint8_t * _F, std::size_t _Length)
+        {
+        memset(_F, 0, _Length);
+        _F[_Length - 1] = DECPPLUS;
+        }
+
+// the general conversions, through decPacked.c and decNumber
+template <class _Fmt>
+static uint32_t _FromPackedViaNumber(const uint8_t * _F, std::size_t _Length,
+                                     int _Scale, _Fmt & _V)
+        {
+        typedef _FmtTraits<_Fmt> _Tr;
+        typename _Tr::_Context _Ctxt(false);
+        _DecNumber _N;
+        int32_t _S = _Scale;
+        decPackedToNumber(_F, static_cast<int32_t>(_Length), &_S, &_N);
+        _Tr::_FromNumber(&_V, _N, &_Ctxt);
+        return _Ctxt.status;
+        }
+
+template <class _Fmt>
+static uint32_t _ToPackedViaNumber(const _Fmt & _V, uint8_t * _F,
+                                   std::size_t _Length, int _Scale)
+        {
+        typename _FmtTraits<_Fmt>::_Context _Ctxt(false);
+        _Ctxt.digits = static_cast<int32_t>(2 * _Length - 1);
+        const _DecNumber _N(_V);
+        const _DecNumber _Q(static_cast<long long>(-_Scale));
+        _DecNumber _R;
+        decNumberRescale(&_R, &_N, &_Q, &_Ctxt);
+
+        int32_t _S;
+        if (decNumberIsNaN(&_R) ||
+            decPackedFromNumber(_F, static_cast<int32_t>(_Length), &_S,
+                                &_R) == 0)
+                {
+                _WritePackedZero(_F, _Length);
+                return _Ctxt.status | DEC_Invalid_operation;
+                }
+        return _Ctxt.status;
+        }
+
+template <class _Fmt>
+static uint32_t _FromPacked(const uint8_t * _In, std::size_t _Count,
+                            std::size_t _Length, int _Scale,
+                            _Fmt * _Out, std::size_t _Stride)
+        {
+        typedef _BCDFmt<_Fmt> _P;
+        if (_Length == 0 || _Length > _MaxPackedLength)
+                { return DEC_Invalid_operation; }
+        if (_Stride == 0)
+                { _Stride = _Length; }
+
+        // the exponent of every field, if it is in range
+        const long _E = _P::_Bias - static_cast<long>(_Scale);
+        const bool _ExpOk = _E >= 0 && _E < (3L << _P::_ExpCont);
+
+        // the digits are read by the kernel of decSimd.h, which also
+        // rejects a nibble above 9
+        const _SimdPackedFn _Read = _GetSimdKernels()._ReadPacked;
+        uint32_t _Status = 0;
+        unsigned _G[_SimdGroups], _Dec[_P::_Declets];
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += _Stride)
+                {
+                const unsigned _SignN = _Read(_In, _Length, _G);
+                if (_SignN < DECPPLUSALT)
+                        {
+                        _Out[_I] = _Fmt::_GetNAN();
+                        _Status |= DEC_Conversion_syntax;
+                        continue;
+                        }
+
+                bool _Fits = _ExpOk && _G[_P::_Declets] <= 9;
+                for (int _K = _P::_Declets + 1; _K < _SimdGroups; ++_K)
+                        { _Fits = _Fits && _G[_K] == 0; }
+                if (!_Fits)
+                        {
+                        _Status |= _FromPackedViaNumber(_In, _Length, _Scale,
+                                                        _Out[_I]);
+                        continue;
+                        }
+
+                for (int _K = 0; _K != _P::_Declets; ++_K)
+                        { _Dec[_K] = BCD2DPD[_G[_K]]; }
+                const unsigned _Sign = _SignN == DECPMINUS ||
+                                       _SignN == DECPMINUSALT;
+                _Assemble(_Out[_I], _Sign, _G[_P::_Declets],
+                          static_cast<unsigned>(_E), _Dec);
+                }
+        return _Status;
+        }
+
+template <class _Fmt>
+static uint32_t _ToPacked(const _Fmt * _In, std::size_t _Count,
+                          uint8_t * _Out, std::size_t _Length, int _Scale,
+                          std::size_t _Stride)
+        {
+        typedef _BCDFmt<_Fmt> _P;
+        if (_Length == 0 || _Length > _MaxPackedLength)
+                { return DEC_Invalid_operation; }
+        if (_Stride == 0)
+                { _Stride = _Length; }
+        const std::size_t _Digits = 2 * _Length - 1;
+
+        uint32_t _Status = 0;
+        unsigned _G[_P::_Declets + 1];
+        for (std::size_t _I = 0; _I != _Count; ++_I, _Out += _Stride)
+                {
+                unsigned _Sign;
+                int _Exp;
+                if (!_Disassemble(_In[_I], _Sign, _Exp, _G))
+                        {
+                        _WritePackedZero(_Out, _Length);
+                        _Status |= DEC_Invalid_operation;
+                        continue;
+                        }
+
+                // a value with more fraction digits than the field must
+                // be rounded
+                const long _Shift = static_cast<long>(_Exp) + _Scale;
+                if (_Shift < 0)
+                        {
+                        _Status |= _ToPackedViaNumber(_In[_I], _Out, _Length,
+                                                      _Scale);
+                        continue;
+                        }
+
+                const std::size_t _Sig = _SigDigits(_G, _P::_Declets + 1);
+                if (_Sig != 0 && _Sig + _Shift > _Digits)
+                        {
+                        _WritePackedZero(_Out, _Length);
+                        _Status |= DEC_Invalid_operation;
+                        continue;
+                        }
+
+                _WritePacked(_Out, _Length, _Sign ? DECPMINUS : DECPPLUS,
+                             _Sig != 0 ? _Shift : 0, _G, _P::_Declets + 1);
+                }
+        return _Status;
+        }
+
+uint32_t from_packed(const uint8_t * _In, std::size_t _Count,
+                     std::size_t _Length, int _Scale,
+                     decimal64 * _Out, std::size_t _Stride)
+        { return _FromPacked(_In, _Count, _Length, _Scale, _Out, _Stride); }
+
+uint32_t from_packed(const uint8_t * _In, std::size_t _Count,
+                     std::size_t _Length, int _Scale,
+                     decimal128 * _Out, std::size_t _Stride)
+        { return _FromPacked(_In, _Count, _Length, _Scale, _Out, _Stride); }
+
+uint32_t to_packed(const decimal64 * _In, std::size_t _Count,
+                   uint8_t * _Out, std::size_t _Length, int _Scale,
+                   std::size_t _Stride)
+        { return _ToPacked(_In, _Count, _Out, _Length, _Scale, _Stride); }
+
+uint32_t to_packed(const decimal128 * _In, std::size_t _Count,
+                   uint8_t * _Out, std::size_t _Length, int _Scale,
+                   std::size_t _Stride)
+        { return _ToPacked(_In, _Count, _Out, _Length, _Scale, _Stride); }
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,402 @@
+/* ------------------------------------------------------------------ */
+/* decScaled.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+
+#include "decscaled"
+#include "impl/decKernel.h"
+
+namespace std {
+namespace decimal {
+
+// The magnitudes are held in arrays of 64-bit limbs, least significant
+// first; products and scaled dividends take up to twice the limbs of the
+// type, and conversions from the formats up to _WorkLimbs.
+static const int _WorkLimbs = 4;
+
+static bool _IsZero(const uint64_t * _N, int _Count)
+        {
+        uint64_t _Or = 0;
+        for (int _I = 0; _I != _Count; ++_I)
+                { _Or |= _N[_I]; }
+        return _Or == 0;
+        }
+
+// divides _N by _D in place, and returns the remainder
+static uint32_t _DivLimbs(uint64_t * _N, int _Count, uint32_t _D)
+        {
+        uint64_t _R = 0;
+        for (int _I = _Count - 1; _I >= 0; --_I)
+                {
+                uint64_t _T = _R << 32 | _N[_I] >> 32;
+                const uint64_t _Hi = _T / _D;
+                _R = _T % _D;
+                _T = _R << 32 | (_N[_I] & 0xFFFFFFFFULL);
+                _N[_I] = _Hi << 32 | _T / _D;
+                _R = _T % _D;
+                }
+        return static_cast<uint32_t>(_R);
+        }
+
+// multiplies _N by _M in place, and returns the carry out of it
+static uint64_t _MulLimbs(uint64_t * _N, int _Count, uint64_t _M)
+        {
+        uint64_t _Carry = 0;
+        for (int _I = 0; _I != _Count; ++_I)
+                {
+                const _Uint128 _P = _Add64(_Mul64(_N[_I], _M), _Carry);
+                _N[_I] = _P._Lo;
+                _Carry = _P._Hi;
+                }
+        return _Carry;
+        }
+
+// the last digit of _N; 2^(64 * _I) ends in 6 for every _I above zero
+static unsigned _LastDigit(const uint64_t * _N, int _Count)
+        {
+        unsigned _D = static_cast<unsigned>(_N[0] % 10);
+        for (int _I = 1; _I != _Count; ++_I)
+                { _D += 6 * static_cast<unsigned>(_N[_I] % 10); }
+        return _D % 10;
+        }
+
+static void _Increment(uint64_t * _N, int _Count)
+        {
+        for (int _I = 0; _I != _Count && ++_N[_I] == 0; ++_I)
+                { }
+        }
+
+// Does _N fit _Limbs limbs, below 2^(64 * _Limbs - 1)?
+static bool _Fits(const uint64_t * _N, int _Count, int _Limbs)
+        {
+        return _IsZero(_N + _Limbs, _Count - _Limbs) &&
+               (_N[_Limbs - 1] >> 63) == 0;
+        }
+
+static void _Saturate(uint64_t * _Out, int _Limbs)
+        {
+        for (int _I = 0; _I != _Limbs; ++_I)
+                { _Out[_I] = ~static_cast<uint64_t>(0); }
+        _Out[_Limbs - 1] >>= 1;
+        }
+
+// Stores _N in _Out, or the largest magnitude if it does not fit, and
+// returns _Status with the flags of an overflow if so.
+static uint32_t _Result(const uint64_t * _N, int _Count, int _Limbs,
+                        uint32_t _Status, uint64_t * _Out)
+        {
+        if (!_Fits(_N, _Count, _Limbs))
+                {
+                _Saturate(_Out, _Limbs);
+                return _Status | DEC_Overflow | DEC_Inexact | DEC_Rounded;
+                }
+        for (int _I = 0; _I != _Limbs; ++_I)
+                { _Out[_I] = _N[_I]; }
+        return _Status;
+        }
+
+// Rounds _Digits digits off _N in _Mode, and returns DEC_Inexact and
+// DEC_Rounded if any of them was nonzero.
+static uint32_t _DropDigits(uint64_t * _N, int _Count, int _Digits,
+                            unsigned _Sign, int _Mode)
+        {
+        if (_Digits <= 0)
+                { return 0; }
+        unsigned _First = 0;
+        bool _Sticky = false;
+        if (_Digits > 20 * _Count)
+                {
+                // _N is below 10^(_Digits - 1), since 2^64 < 10^20
+                _Sticky = !_IsZero(_N, _Count);
+                for (int _I = 0; _I != _Count; ++_I)
+                        { _N[_I] = 0; }
+                }
+        else
+                {
+                // the digits below the first one dropped, nine at a time
+                for (int _D = _Digits - 1; _D > 0; _D -= 9)
+                        {
+                        const int _K = _D < 9 ? _D : 9;
+                        _Sticky |= _DivLimbs(_N, _Count, static_cast<uint32_t>(
+                                        _KernelPow10[_K])) != 0;
+                        }
+                _First = _DivLimbs(_N, _Count, 10);
+                }
+        if (_First == 0 && !_Sticky)
+                { return 0; }
+        if (_RoundsUp(static_cast<rounding>(_Mode), _Sign,
+                      _LastDigit(_N, _Count), _First, _Sticky))
+                { _Increment(_N, _Count); }
+        return DEC_Inexact | DEC_Rounded;
+        }
+
+uint32_t _ScaledMultiply(const uint64_t * _A, const uint64_t * _B,
+                         int _Limbs, int _Scale, unsigned _Sign, int _Mode,
+                         uint64_t * _Out)
+        {
+        uint64_t _P[2 * 2] = { 0, 0, 0, 0 };
+        for (int _I = 0; _I != _Limbs; ++_I)
+                {
+                uint64_t _Carry = 0;
+                for (int _J = 0; _J != _Limbs; ++_J)
+                        {
+                        const _Uint128 _T = _Add64(_Add64(
+                                _Mul64(_A[_I], _B[_J]), _P[_I + _J]), _Carry);
+                        _P[_I + _J] = _T._Lo;
+                        _Carry = _T._Hi;
+                        }
+                _P[_I + _Limbs] = _Carry;
+                }
+        const uint32_t _Status = _DropDigits(_P, 2 * _Limbs, _Scale, _Sign,
+                                             _Mode);
+        return _Result(_P, 2 * _Limbs, _Limbs, _Status, _Out);
+        }
+
+// Divides _N, of _Count limbs, by _B, of _Limbs limbs and not zero,
+// leaving the quotient in _N and the remainder in _R.
+static void _DivideLimbs(uint64_t * _N, int _Count, const uint64_t * _B,
+                         int _Limbs, uint64_t * _R)
+        {
+        for (int _I = 0; _I != _Limbs; ++_I)
+                { _R[_I] = 0; }
+        if (_IsZero(_B + 1, _Limbs - 1) && (_B[0] >> 32) == 0)
+                {
+                _R[0] = _DivLimbs(_N, _Count,
+                                  static_cast<uint32_t>(_B[0]));
+                return;
+                }
+#if defined(_DEC_HAS_INT128)
+        if (_Limbs == 1 && _Count == 2)
+                {
+                const _NativeUint128 _X =
+                        static_cast<_NativeUint128>(_N[1]) << 64 | _N[0];
+                const _NativeUint128 _Q = _X / _B[0];
+                _R[0] = static_cast<uint64_t>(_X % _B[0]);
+                _N[0] = static_cast<uint64_t>(_Q);
+                _N[1] = static_cast<uint64_t>(_Q >> 64);
+                return;
+                }
+#endif /* defined(_DEC_HAS_INT128) */
+
+        // one bit at a time; the remainder stays below _B, and so below
+        // 2^(64 * _Limbs - 1), so that doubling it cannot carry out
+        for (int _Bit = 64 * _Count - 1; _Bit >= 0; --_Bit)
+                {
+                uint64_t _In = _N[_Bit / 64] >> (_Bit % 64) & 1;
+                for (int _I = 0; _I != _Limbs; ++_I)
+                        {
+                        const uint64_t _Out = _R[_I] >> 63;
+                        _R[_I] = _R[_I] << 1 | _In;
+                        _In = _Out;
+                        }
+                bool _Less = false;
+                for (int _I = _Limbs - 1; _I >= 0; --_I)
+                        {
+                        if (_R[_I] != _B[_I])
+                                {
+                                _Less = _R[_I] < _B[_I];
+                                break;
+                                }
+                        }
+                const uint64_t _Mask = static_cast<uint64_t>(1) << (_Bit % 64);
+                if (_Less)
+                        {
+                        _N[_Bit / 64] &= ~_Mask;
+                        continue;
+                        }
+                uint64_t _Borrow = 0;
+                for (int _I = 0; _I != _Limbs; ++_I)
+                        {
+                        const uint64_t _D = _R[_I] - _B[_I] - _Borrow;
+                        _Borrow = _R[_I] < _B[_I] ||
+                                  (_R[_I] == _B[_I] && _Borrow != 0);
+                        _R[_I] = _D;
+                        }
+                _N[_Bit / 64] |= _Mask;
+                }
+        }
+
+uint32_t _ScaledDivide(const uint64_t * _A, const uint64_t * _B,
+                       int _Limbs, int _Scale, unsigned _Sign, int _Mode,
+                       uint64_t * _Out)
+        {
+        if (_IsZero(_B, _Limbs))
+                {
+                if (_IsZero(_A, _Limbs))
+                        {
+                        for (int _I = 0; _I != _Limbs; ++_I)
+                                { _Out[_I] = 0; }
+                        return DEC_Division_undefined;
+                        }
+                _Saturate(_Out, _Limbs);
+                return DEC_Division_by_zero;
+                }
+
+        // the quotient of _A * 10^_Scale, which fits twice the limbs
+        const int _Count = 2 * _Limbs;
+        uint64_t _N[2 * 2] = { 0, 0, 0, 0 };
+        for (int _I = 0; _I != _Limbs; ++_I)
+                { _N[_I] = _A[_I]; }
+        for (int _D = _Scale; _D > 0; _D -= 19)
+                { _MulLimbs(_N, _Count, _KernelPow10[_D < 19 ? _D : 19]); }
+        uint64_t _R[2];
+        _DivideLimbs(_N, _Count, _B, _Limbs, _R);
+        if (_IsZero(_R, _Limbs))
+                { return _Result(_N, _Count, _Limbs, 0, _Out); }
+
+        // the first digit dropped is 5 or more as 2 * _R >= _B, and the
+        // digits after it are zero only if 2 * _R == _B
+        int _Cmp = 0;
+        for (int _I = _Limbs - 1; _I >= 0 && _Cmp == 0; --_I)
+                {
+                const uint64_t _Twice = _R[_I] << 1 |
+                                        (_I == 0 ? 0 : _R[_I - 1] >> 63);
+                _Cmp = _Twice < _B[_I] ? -1 : _Twice > _B[_I] ? 1 : 0;
+                }
+        const unsigned _First = _Cmp < 0 ? 0 : 5;
+        if (_RoundsUp(static_cast<rounding>(_Mode), _Sign,
+                      _LastDigit(_N, _Count), _First, _Cmp != 0))
+                { _Increment(_N, _Count); }
+        return _Result(_N, _Count, _Limbs, DEC_Inexact | DEC_Rounded, _Out);
+        }
+
+// the finite value _C * 10^_Exp, with _C of two limbs, rounded to the
+// scale
+static uint32_t _FromCoeff(const uint64_t * _C, int _Exp, unsigned _Sign,
+                           int _Limbs, int _Scale, int _Mode, uint64_t * _Out)
+        {
+        uint64_t _N[_WorkLimbs] = { _C[0], _C[1], 0, 0 };
+        const int _Shift = _Exp + _Scale;
+        if (_Shift < 0)
+                {
+                const uint32_t _Status = _DropDigits(_N, _WorkLimbs, -_Shift,
+                                                     _Sign, _Mode);
+                return _Result(_N, _WorkLimbs, _Limbs, _Status, _Out);
+                }
+
+        // _N stays below 2^(64 * _Limbs) before each step, and so below
+        // 2^(64 * _WorkLimbs) after it
+        for (int _D = _Shift; _D > 0 && _Fits(_N, _WorkLimbs, _Limbs);
+             _D -= 19)
+                { _MulLimbs(_N, _WorkLimbs, _KernelPow10[_D < 19 ? _D : 19]); }
+        return _Result(_N, _WorkLimbs, _Limbs, 0, _Out);
+        }
+
+// the result of converting a special value
+static uint32_t _FromSpecial(_NativeKind _Kind, unsigned & _Sign,
+                             int _Limbs, uint64_t * _Out)
+        {
+        if (_Kind == _NativeInf)
+                { _Saturate(_Out, _Limbs); }
+        else
+                {
+                _Sign = 0;
+                for (int _I = 0; _I != _Limbs; ++_I)
+                        { _Out[_I] = 0; }
+                }
+        return DEC_Invalid_operation;
+        }
+
+uint32_t _ScaledFromDecimal(decimal64 _V, int _Limbs, int _Scale,
+                            int _Mode, unsigned & _Sign, uint64_t * _Out)
+        {
+        _Native64 _N;
+        _Unpack(_V, _N);
+        _Sign = _N._Sign;
+        if (_N._Kind != _NativeFinite)
+                { return _FromSpecial(_N._Kind, _Sign, _Limbs, _Out); }
+        const uint64_t _C[2] = { _N._Coeff, 0 };
+        return _FromCoeff(_C, _N._Exp, _Sign, _Limbs, _Scale, _Mode, _Out);
+        }
+
+uint32_t _ScaledFromDecimal(decimal128 _V, int _Limbs, int _Scale,
+                            int _Mode, unsigned & _Sign, uint64_t * _Out)
+        {
+        _Native128 _N;
+        _Unpack(_V, _N);
+        _Sign = _N._Sign;
+        if (_N._Kind != _NativeFinite)
+                { return _FromSpecial(_N._Kind, _Sign, _Limbs, _Out); }
+        const uint64_t _C[2] = { _N._Coeff._Lo, _N._Coeff._Hi };
+        return _FromCoeff(_C, _N._Exp, _Sign, _Limbs, _Scale, _Mode, _Out);
+        }
+
+// Rounds the magnitude to _Digits digits, in one step so that it is
+// rounded only once, leaving it in _N and its exponent in _Exp.
+static uint32_t _ToCoeff(unsigned _Sign, const uint64_t * _Mag, int _Limbs,
+                         int _Scale, int _Mode, int _Digits, uint64_t * _N,
+                         int & _Exp)
+        {
+        _N[0] = _Mag[0];
+        _N[1] = _Limbs == 2 ? _Mag[1] : 0;
+        const _Uint128 & _Max = _KernelPow10W[_Digits];
+        int _Drop = 0;
+        uint64_t _T[2] = { _N[0], _N[1] };
+        while (!(_MakeUint128(_T[1], _T[0]) < _Max))
+                {
+                _DivLimbs(_T, 2, 10);
+                ++_Drop;
+                }
+        const uint32_t _Status = _DropDigits(_N, 2, _Drop, _Sign, _Mode);
+        if (!(_MakeUint128(_N[1], _N[0]) < _Max))
+                {
+                // rounded up to 10^_Digits
+                _DivLimbs(_N, 2, 10);
+                ++_Drop;
+                }
+        _Exp = _Drop - _Scale;
+        return _Status;
+        }
+
+uint32_t _ScaledToDecimal(unsigned _Sign, const uint64_t * _Mag,
+                          int _Limbs, int _Scale, int _Mode,
+                          decimal64 & _Out)
+        {
+        uint64_t _C[2];
+        _Native64 _N;
+        const uint32_t _Status = _ToCoeff(_Sign, _Mag, _Limbs, _Scale, _Mode,
+                                          16, _C, _N._Exp);
+        _N._Sign = _Sign;
+        _N._Kind = _NativeFinite;
+        _N._Coeff = _C[0];
+        _Pack(_Out, _N);
+        return _Status;
+        }
+
+uint32_t _ScaledToDecimal(unsigned _Sign, const uint64_t * _Mag,
+                          int _Limbs, int _Scale, int _Mode,
+                          decimal128 & _Out)
+        {
+        uint64_t _C[2];
+        _Native128 _N;
+        const uint32_t _Status = _ToCoeff(_Sign, _Mag, _Limbs, _Scale, _Mode,
+                                          34, _C, _N._Exp);
+        _N._Sign = _Sign;
+        _N._Kind = _NativeFinite;
+        _N._Coeff = _MakeUint128(_C[1], _C[0]);
+        _Pack(_Out, _N);
+        return _Status;
+        }
+
+void _ScaledReport(uint32_t _Status)
+        {
+        const _Context64 _Ctxt(false);
+        if ((_Status & (DEC_Invalid_operation | DEC_Division_undefined)) != 0)
+                { _Ctxt._DomainError(); }
+        else if ((_Status & (DEC_Overflow | DEC_Division_by_zero)) != 0)
+                { _Ctxt._RangeError(); }
+        }
+
+} // namespace decimal
+} // namespace std
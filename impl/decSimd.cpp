@@ -0,0 +1,981 @@
+/* ------------------------------------------------------------------ */
+/* decSimd.cpp source file                                            */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "impl/decSimd.h"
+#include "impl/decNative.h"
+
+// the values of the declets times 1000 and times 10^6, as 32-bit tables
+// that the vector kernels can gather from
+#define DEC_DPD2BINK 1
+#define DEC_DPD2BINM 1
+#include "decDPD.h"
+
+#if defined(_DEC_HAS_X86_SIMD)
+#include <immintrin.h>
+#endif /* defined(_DEC_HAS_X86_SIMD) */
+
+namespace std {
+namespace decimal {
+
+// the smallest exponent of a normal result, and the largest coefficient
+// plus one, of decimal64
+static const int      _SimdEmin = -383;
+static const uint64_t _SimdLimit = 10000000000000000ULL;
+
+// For the conversions: the inverse of 125 modulo 2^32, which divides
+// multiples of 125 exactly, and the factor that gives _X / 1000 as
+// _X * _Div1000 >> 38 for any 32-bit _X.
+static const int       _Inverse125 = 0x26E978D5;
+static const long long _Div1000 = 274877907;
+
+// value _I of _X with its sign, as an integer
+static inline int64_t _Signed(const _SimdOperand & _X, int _I)
+        {
+        const int64_t _C = static_cast<int64_t>(_X._Coeff[_I]);
+        return (_X._Signs >> _I & 1) != 0 ? -_C : _C;
+        }
+
+// true if values _I of _A and _B are finite with the same exponent
+static inline bool _Aligned(const _SimdOperand & _A, const _SimdOperand & _B,
+                            int _I)
+        {
+        return ((_A._Specials | _B._Specials) >> _I & 1) == 0 &&
+               _A._Exp[_I] == _B._Exp[_I];
+        }
+
+// The portable kernels, for values [_First, _Count) of the block; the
+// vector kernels finish a block with them.
+static uint64_t _AddLanes(const _SimdOperand & _A, const _SimdOperand & _B,
+                          int _First, int _Count, uint64_t * _Coeff,
+                          uint64_t & _Signs)
+        {
+        uint64_t _Done = 0;
+        for (int _I = _First; _I != _Count; ++_I)
+                {
+                const int64_t _S = _Signed(_A, _I) + _Signed(_B, _I);
+                const uint64_t _M = _S < 0 ? 0 - static_cast<uint64_t>(_S) :
+                                             static_cast<uint64_t>(_S);
+                const uint64_t _Bit = static_cast<uint64_t>(1) << _I;
+                _Coeff[_I] = _M;
+                if (_S < 0)
+                        { _Signs |= _Bit; }
+                if (_Aligned(_A, _B, _I) && _A._Exp[_I] >= _SimdEmin &&
+                    _S != 0 && _M < _SimdLimit)
+                        { _Done |= _Bit; }
+                }
+        return _Done;
+        }
+
+static uint64_t _CompareLanes(const _SimdOperand & _A,
+                              const _SimdOperand & _B, int _First,
+                              int _Count, int8_t * _Out)
+        {
+        uint64_t _Done = 0;
+        for (int _I = _First; _I != _Count; ++_I)
+                {
+                const int64_t _VA = _Signed(_A, _I), _VB = _Signed(_B, _I);
+                _Out[_I] = static_cast<int8_t>((_VA > _VB) - (_VA < _VB));
+                if (_Aligned(_A, _B, _I))
+                        { _Done |= static_cast<uint64_t>(1) << _I; }
+                }
+        return _Done;
+        }
+
+static uint64_t _MinMaxLanes(const _SimdOperand & _A,
+                             const _SimdOperand & _B, int _First,
+                             int _Count, bool _Max, uint64_t & _FromB)
+        {
+        uint64_t _Done = 0;
+        for (int _I = _First; _I != _Count; ++_I)
+                {
+                const int64_t _VA = _Signed(_A, _I), _VB = _Signed(_B, _I);
+                const uint64_t _Bit = static_cast<uint64_t>(1) << _I;
+                if (_Max ? _VB > _VA : _VB < _VA)
+                        { _FromB |= _Bit; }
+                // zeros of opposite signs are ordered by their signs
+                if (_Aligned(_A, _B, _I) && _A._Exp[_I] >= _SimdEmin &&
+                    (_VA != _VB || ((_A._Signs ^ _B._Signs) & _Bit) == 0))
+                        { _Done |= _Bit; }
+                }
+        return _Done;
+        }
+
+// value _I of a block held in the column arrays _X, as unpacked
+static void _LaneOf(const _SimdOperand & _X, int _I, _Native64 & _N)
+        {
+        _N._Sign = static_cast<unsigned>(_X._Signs >> _I & 1);
+        if ((_X._Specials >> _I & 1) != 0)
+                {
+                _N._Kind = static_cast<_NativeKind>(_X._Exp[_I]);
+                _N._Exp = 0;
+                }
+        else
+                {
+                _N._Kind = _NativeFinite;
+                _N._Exp = _X._Exp[_I];
+                }
+        _N._Coeff = _X._Coeff[_I];
+        }
+
+static uint64_t _DecodeLanes(const uint64_t * _In, int _First, int _Count,
+                             uint64_t * _Coeff, int16_t * _Exp,
+                             uint64_t & _Signs)
+        {
+        uint64_t _Specials = 0;
+        for (int _I = _First; _I != _Count; ++_I)
+                {
+                _Native64 _N;
+                _UnpackDPD<_Layout64>(_In[_I], _N);
+                const uint64_t _Bit = static_cast<uint64_t>(1) << _I;
+                _Coeff[_I] = _N._Coeff;
+                _Exp[_I] = static_cast<int16_t>(
+                        _N._Kind == _NativeFinite ? _N._Exp : _N._Kind);
+                if (_N._Sign != 0)
+                        { _Signs |= _Bit; }
+                if (_N._Kind != _NativeFinite)
+                        { _Specials |= _Bit; }
+                }
+        return _Specials;
+        }
+
+static void _EncodeLanes(const _SimdOperand & _X, int _First, int _Count,
+                         uint64_t * _Out)
+        {
+        for (int _I = _First; _I != _Count; ++_I)
+                {
+                _Native64 _N;
+                _LaneOf(_X, _I, _N);
+                _Out[_I] = _PackDPD<_Layout64>(_N);
+                }
+        }
+
+static uint64_t _AddPortable(const _SimdOperand & _A,
+                             const _SimdOperand & _B, int _Count,
+                             uint64_t * _Coeff, uint64_t & _Signs)
+        {
+        _Signs = 0;
+        return _AddLanes(_A, _B, 0, _Count, _Coeff, _Signs);
+        }
+
+static uint64_t _ComparePortable(const _SimdOperand & _A,
+                                 const _SimdOperand & _B, int _Count,
+                                 int8_t * _Out)
+        { return _CompareLanes(_A, _B, 0, _Count, _Out); }
+
+static uint64_t _MinMaxPortable(const _SimdOperand & _A,
+                                const _SimdOperand & _B, int _Count,
+                                bool _Max, uint64_t & _FromB)
+        {
+        _FromB = 0;
+        return _MinMaxLanes(_A, _B, 0, _Count, _Max, _FromB);
+        }
+
+static uint64_t _DecodePortable(const uint64_t * _In, int _Count,
+                                uint64_t * _Coeff, int16_t * _Exp,
+                                uint64_t & _Signs)
+        {
+        _Signs = 0;
+        return _DecodeLanes(_In, 0, _Count, _Coeff, _Exp, _Signs);
+        }
+
+static void _EncodePortable(const _SimdOperand & _X, int _Count,
+                            uint64_t * _Out)
+        { _EncodeLanes(_X, 0, _Count, _Out); }
+
+static unsigned _ReadPackedPortable(const uint8_t * _F,
+                                   std::size_t _Length, unsigned * _G)
+        {
+        for (int _K = 0; _K != _SimdGroups; ++_K)
+                { _G[_K] = 0; }
+
+        const uint8_t * _P = _F + _Length - 1;
+        const unsigned _SignN = *_P & 0xF;
+        _G[0] = *_P >> 4;
+
+        // a nibble above 9 sets bit 4 of _Bad
+        unsigned _Bad = _G[0] + 6;
+        std::size_t _J = 1;
+        while (_P != _F)
+                {
+                --_P;
+                const unsigned _Lo = *_P & 0xF, _Hi = *_P >> 4;
+                _Bad |= (_Lo + 6) | (_Hi + 6);
+                _G[_J / 3] |= _Lo << (4 * (_J % 3));
+                ++_J;
+                _G[_J / 3] |= _Hi << (4 * (_J % 3));
+                ++_J;
+                }
+        return (_Bad & 0x10) != 0 ? 0 : _SignN;
+        }
+
+static const _SimdKernels _Portable = {
+        _AddPortable, _ComparePortable, _MinMaxPortable, _DecodePortable,
+        _EncodePortable, _ReadPackedPortable
+};
+
+#if defined(_DEC_HAS_X86_SIMD)
+
+#define _DEC_AVX2   __attribute__((target("avx2")))
+#define _DEC_AVX512 __attribute__((target("avx512f")))
+
+// Four values at a time.  The signs and specials of lanes _I to _I + 3
+// are spread into lane masks, the coefficients are given their signs,
+// and the results of the lanes are gathered with movemask.
+_DEC_AVX2 static inline __m256i _LaneMask4(uint64_t _Bits, int _I)
+        {
+        const __m256i _Sel = _mm256_set_epi64x(8, 4, 2, 1);
+        const __m256i _B = _mm256_set1_epi64x(
+                static_cast<long long>(_Bits >> _I & 0xF));
+        return _mm256_cmpeq_epi64(_mm256_and_si256(_B, _Sel), _Sel);
+        }
+
+_DEC_AVX2 static inline __m256i _Signed4(const _SimdOperand & _X, int _I)
+        {
+        const __m256i _C = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(_X._Coeff + _I));
+        const __m256i _M = _LaneMask4(_X._Signs, _I);
+        return _mm256_sub_epi64(_mm256_xor_si256(_C, _M), _M);
+        }
+
+_DEC_AVX2 static inline __m256i _Exp4(const _SimdOperand & _X, int _I)
+        {
+        return _mm256_cvtepi16_epi64(_mm_loadl_epi64(
+                reinterpret_cast<const __m128i *>(_X._Exp + _I)));
+        }
+
+_DEC_AVX2 static inline uint64_t _Bits4(__m256i _M)
+        {
+        return static_cast<uint64_t>(
+                _mm256_movemask_pd(_mm256_castsi256_pd(_M)));
+        }
+
+// the lanes of finite values with the same exponent, and with _Normal,
+// a normal one
+_DEC_AVX2 static inline __m256i _Aligned4(const _SimdOperand & _A,
+                                          const _SimdOperand & _B, int _I,
+                                          bool _Normal)
+        {
+        const __m256i _EA = _Exp4(_A, _I);
+        __m256i _Ok = _mm256_andnot_si256(
+                _LaneMask4(_A._Specials | _B._Specials, _I),
+                _mm256_cmpeq_epi64(_EA, _Exp4(_B, _I)));
+        if (_Normal)
+                {
+                _Ok = _mm256_and_si256(_Ok, _mm256_cmpgt_epi64(
+                        _EA, _mm256_set1_epi64x(_SimdEmin - 1)));
+                }
+        return _Ok;
+        }
+
+_DEC_AVX2 static uint64_t _AddAVX2(const _SimdOperand & _A,
+                                   const _SimdOperand & _B, int _Count,
+                                   uint64_t * _Coeff, uint64_t & _Signs)
+        {
+        const __m256i _Zero = _mm256_setzero_si256();
+        const __m256i _Limit = _mm256_set1_epi64x(
+                static_cast<long long>(_SimdLimit));
+        uint64_t _Done = 0;
+        _Signs = 0;
+        int _I = 0;
+        for (; _I + 4 <= _Count; _I += 4)
+                {
+                const __m256i _S = _mm256_add_epi64(_Signed4(_A, _I),
+                                                    _Signed4(_B, _I));
+                const __m256i _Neg = _mm256_cmpgt_epi64(_Zero, _S);
+                const __m256i _M = _mm256_sub_epi64(
+                        _mm256_xor_si256(_S, _Neg), _Neg);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(_Coeff + _I),
+                                    _M);
+                const __m256i _Ok = _mm256_andnot_si256(
+                        _mm256_cmpeq_epi64(_S, _Zero),
+                        _mm256_and_si256(_Aligned4(_A, _B, _I, true),
+                                         _mm256_cmpgt_epi64(_Limit, _M)));
+                _Signs |= _Bits4(_Neg) << _I;
+                _Done |= _Bits4(_Ok) << _I;
+                }
+        return _Done | _AddLanes(_A, _B, _I, _Count, _Coeff, _Signs);
+        }
+
+_DEC_AVX2 static uint64_t _CompareAVX2(const _SimdOperand & _A,
+                                       const _SimdOperand & _B, int _Count,
+                                       int8_t * _Out)
+        {
+        uint64_t _Done = 0;
+        int _I = 0;
+        for (; _I + 4 <= _Count; _I += 4)
+                {
+                const __m256i _VA = _Signed4(_A, _I), _VB = _Signed4(_B, _I);
+                const uint64_t _Lt = _Bits4(_mm256_cmpgt_epi64(_VB, _VA));
+                const uint64_t _Gt = _Bits4(_mm256_cmpgt_epi64(_VA, _VB));
+                for (int _K = 0; _K != 4; ++_K)
+                        {
+                        _Out[_I + _K] = static_cast<int8_t>(
+                                (_Gt >> _K & 1) - (_Lt >> _K & 1));
+                        }
+                _Done |= _Bits4(_Aligned4(_A, _B, _I, false)) << _I;
+                }
+        return _Done | _CompareLanes(_A, _B, _I, _Count, _Out);
+        }
+
+_DEC_AVX2 static uint64_t _MinMaxAVX2(const _SimdOperand & _A,
+                                      const _SimdOperand & _B, int _Count,
+                                      bool _Max, uint64_t & _FromB)
+        {
+        uint64_t _Done = 0;
+        _FromB = 0;
+        int _I = 0;
+        for (; _I + 4 <= _Count; _I += 4)
+                {
+                const __m256i _VA = _Signed4(_A, _I), _VB = _Signed4(_B, _I);
+                const __m256i _Pick = _Max ? _mm256_cmpgt_epi64(_VB, _VA) :
+                                             _mm256_cmpgt_epi64(_VA, _VB);
+                const __m256i _Tie = _mm256_and_si256(
+                        _mm256_cmpeq_epi64(_VA, _VB),
+                        _LaneMask4(_A._Signs ^ _B._Signs, _I));
+                _FromB |= _Bits4(_Pick) << _I;
+                _Done |= _Bits4(_mm256_andnot_si256(
+                        _Tie, _Aligned4(_A, _B, _I, true))) << _I;
+                }
+        return _Done | _MinMaxLanes(_A, _B, _I, _Count, _Max, _FromB);
+        }
+
+// The units of four declets from their thousands, a multiple of 1000
+// divided by 8 and then exactly by 125.
+_DEC_AVX2 static inline __m128i _Units4(__m128i _Thousands)
+        {
+        return _mm_mullo_epi32(_mm_srli_epi32(_Thousands, 3),
+                               _mm_set1_epi32(_Inverse125));
+        }
+
+// entry _Table[d] for declet _K of each lane of _W
+_DEC_AVX2 static inline __m128i _Gather4(const uint32_t * _Table, __m256i _W,
+                                         int _K)
+        {
+        const __m256i _D = _mm256_and_si256(
+                _mm256_srl_epi64(_W, _mm_cvtsi32_si128(10 * _K)),
+                _mm256_set1_epi64x(0x3FF));
+        return _mm256_i64gather_epi32(
+                reinterpret_cast<const int *>(_Table), _D, 4);
+        }
+
+// the low halves of the four 64-bit lanes of _X
+_DEC_AVX2 static inline __m128i _Low32x4(__m256i _X)
+        {
+        return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+                _X, _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0)));
+        }
+
+// Four encodings at a time, as _UnpackDPD would unpack them if they were
+// finite; the special values are unpacked again one at a time.
+_DEC_AVX2 static uint64_t _DecodeAVX2(const uint64_t * _In, int _Count,
+                                      uint64_t * _Coeff, int16_t * _Exp,
+                                      uint64_t & _Signs)
+        {
+        const __m256i _Inf = _mm256_set1_epi64x(0x78LL << 56);
+        const __m256i _Large = _mm256_set1_epi64x(0x18);
+        uint64_t _Specials = 0;
+        _Signs = 0;
+        int _I = 0;
+        for (; _I + 4 <= _Count; _I += 4)
+                {
+                const __m256i _W = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(_In + _I));
+
+                // the nine digits of the upper three declets and the six
+                // of the lower two
+                const __m128i _Hi = _mm_add_epi32(
+                        _mm_add_epi32(_Gather4(DPD2BINM, _W, 4),
+                                      _Gather4(DPD2BINK, _W, 3)),
+                        _Units4(_Gather4(DPD2BINK, _W, 2)));
+                const __m128i _Lo = _Units4(_mm_add_epi32(
+                        _Gather4(DPD2BINM, _W, 1), _Gather4(DPD2BINK, _W, 0)));
+
+                // the combination field (see _DecodeComb)
+                const __m256i _Comb = _mm256_and_si256(
+                        _mm256_srli_epi64(_W, 58), _mm256_set1_epi64x(0x1F));
+                const __m256i _IsLarge = _mm256_cmpeq_epi64(
+                        _mm256_and_si256(_Comb, _Large), _Large);
+                const __m256i _Msd = _mm256_blendv_epi8(
+                        _mm256_and_si256(_Comb, _mm256_set1_epi64x(7)),
+                        _mm256_or_si256(
+                                _mm256_and_si256(_Comb, _mm256_set1_epi64x(1)),
+                                _mm256_set1_epi64x(8)),
+                        _IsLarge);
+                const __m256i _ExpHi = _mm256_blendv_epi8(
+                        _mm256_srli_epi64(_Comb, 3),
+                        _mm256_and_si256(_mm256_srli_epi64(_Comb, 1),
+                                         _mm256_set1_epi64x(3)),
+                        _IsLarge);
+                const __m256i _E = _mm256_sub_epi64(
+                        _mm256_or_si256(
+                                _mm256_slli_epi64(_ExpHi, 8),
+                                _mm256_and_si256(_mm256_srli_epi64(_W, 50),
+                                                 _mm256_set1_epi64x(0xFF))),
+                        _mm256_set1_epi64x(_Layout64::_Bias));
+
+                const __m256i _C = _mm256_add_epi64(
+                        _mm256_add_epi64(
+                                _mm256_mul_epu32(_mm256_cvtepu32_epi64(_Hi),
+                                                 _mm256_set1_epi64x(1000000)),
+                                _mm256_cvtepu32_epi64(_Lo)),
+                        _mm256_mul_epu32(
+                                _mm256_mul_epu32(_Msd,
+                                                 _mm256_set1_epi64x(1000000)),
+                                _mm256_set1_epi64x(1000000000)));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(_Coeff + _I),
+                                    _C);
+                const __m128i _E32 = _Low32x4(_E);
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(_Exp + _I),
+                                 _mm_packs_epi32(_E32, _E32));
+                _Signs |= _Bits4(_W) << _I;
+                _Specials |= _Bits4(_mm256_cmpeq_epi64(
+                        _mm256_and_si256(_W, _Inf), _Inf)) << _I;
+                }
+        for (int _K = 0; _Specials != 0 && _K != _I; ++_K)
+                {
+                if ((_Specials >> _K & 1) != 0)
+                        {
+                        _DecodeLanes(_In, _K, _K + 1, _Coeff, _Exp,
+                                     _Signs);
+                        }
+                }
+        return _Specials | _DecodeLanes(_In, _I, _Count, _Coeff, _Exp, _Signs);
+        }
+
+// _X / 1000 and _X % 1000, for lanes below 2^32
+_DEC_AVX2 static inline __m256i _Div1000x4(__m256i _X)
+        {
+        return _mm256_srli_epi64(
+                _mm256_mul_epu32(_X, _mm256_set1_epi64x(_Div1000)), 38);
+        }
+
+_DEC_AVX2 static inline __m256i _Mod1000x4(__m256i _X, __m256i _Div)
+        {
+        return _mm256_sub_epi64(
+                _X, _mm256_mul_epu32(_Div, _mm256_set1_epi64x(1000)));
+        }
+
+// The declets of lanes below 1000.  Each is the upper half of a 32-bit
+// load that ends at its entry of BIN2DPD, so that no load leaves the
+// table; the load for zero, whose declet is zero, is masked off.
+_DEC_AVX2 static inline __m256i _Declet4(__m256i _G)
+        {
+        const __m128i _N = _Low32x4(_G);
+        const __m128i _D = _mm_mask_i32gather_epi32(
+                _mm_setzero_si128(), reinterpret_cast<const int *>(BIN2DPD),
+                _mm_sub_epi32(_mm_add_epi32(_N, _N), _mm_set1_epi32(2)),
+                _mm_cmpgt_epi32(_N, _mm_setzero_si128()), 1);
+        return _mm256_cvtepu32_epi64(_mm_srli_epi32(_D, 16));
+        }
+
+// Four values at a time, as _PackDPD would pack them if they were
+// finite; the special values are packed again one at a time.  The
+// coefficients are split at 10^9 by an estimate of the quotient in
+// double precision, which is off by at most one, and the parts into
+// declets by multiplication.
+_DEC_AVX2 static void _EncodeAVX2(const _SimdOperand & _X, int _Count,
+                                  uint64_t * _Out)
+        {
+        const __m256d _Two52 = _mm256_set1_pd(4503599627370496.0);
+        const __m256i _Bias52 = _mm256_castpd_si256(_Two52);
+        const __m256i _Billion = _mm256_set1_epi64x(1000000000);
+        int _I = 0;
+        for (; _I + 4 <= _Count; _I += 4)
+                {
+                const __m256i _C = _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(_X._Coeff + _I));
+
+                // the halves of _C as doubles, exactly
+                const __m256d _CH = _mm256_sub_pd(_mm256_castsi256_pd(
+                        _mm256_or_si256(_mm256_srli_epi64(_C, 32), _Bias52)),
+                        _Two52);
+                const __m256d _CL = _mm256_sub_pd(_mm256_castsi256_pd(
+                        _mm256_or_si256(
+                                _mm256_and_si256(_C, _mm256_set1_epi64x(
+                                        0xFFFFFFFFLL)),
+                                _Bias52)),
+                        _Two52);
+                const __m256d _Est = _mm256_floor_pd(_mm256_mul_pd(
+                        _mm256_add_pd(_mm256_mul_pd(
+                                _CH, _mm256_set1_pd(4294967296.0)), _CL),
+                        _mm256_set1_pd(1e-9)));
+                __m256i _Q = _mm256_sub_epi64(_mm256_castpd_si256(
+                        _mm256_add_pd(_Est, _Two52)), _Bias52);
+                __m256i _R = _mm256_sub_epi64(_C,
+                                              _mm256_mul_epu32(_Q, _Billion));
+                const __m256i _Under = _mm256_cmpgt_epi64(
+                        _mm256_setzero_si256(), _R);
+                _Q = _mm256_add_epi64(_Q, _Under);
+                _R = _mm256_add_epi64(_R, _mm256_and_si256(_Under, _Billion));
+                const __m256i _Over = _mm256_cmpgt_epi64(
+                        _R, _mm256_set1_epi64x(999999999));
+                _Q = _mm256_sub_epi64(_Q, _Over);
+                _R = _mm256_sub_epi64(_R, _mm256_and_si256(_Over, _Billion));
+
+                const __m256i _R1 = _Div1000x4(_R), _R2 = _Div1000x4(_R1);
+                const __m256i _Q1 = _Div1000x4(_Q), _Msd = _Div1000x4(_Q1);
+                __m256i _W = _mm256_or_si256(
+                        _mm256_or_si256(
+                                _Declet4(_Mod1000x4(_R, _R1)),
+                                _mm256_slli_epi64(
+                                        _Declet4(_Mod1000x4(_R1, _R2)), 10)),
+                        _mm256_or_si256(
+                                _mm256_slli_epi64(_Declet4(_R2), 20),
+                                _mm256_or_si256(
+                                        _mm256_slli_epi64(_Declet4(
+                                                _Mod1000x4(_Q, _Q1)), 30),
+                                        _mm256_slli_epi64(_Declet4(
+                                                _Mod1000x4(_Q1, _Msd)), 40))));
+
+                // the combination field (see _EncodeComb)
+                const __m256i _E = _mm256_add_epi64(
+                        _Exp4(_X, _I), _mm256_set1_epi64x(_Layout64::_Bias));
+                const __m256i _ExpHi = _mm256_srli_epi64(_E, 8);
+                const __m256i _Comb = _mm256_blendv_epi8(
+                        _mm256_or_si256(
+                                _mm256_set1_epi64x(0x18),
+                                _mm256_or_si256(
+                                        _mm256_slli_epi64(_ExpHi, 1),
+                                        _mm256_and_si256(
+                                                _Msd, _mm256_set1_epi64x(1)))),
+                        _mm256_or_si256(_mm256_slli_epi64(_ExpHi, 3), _Msd),
+                        _mm256_cmpgt_epi64(_mm256_set1_epi64x(8), _Msd));
+                _W = _mm256_or_si256(
+                        _W,
+                        _mm256_or_si256(
+                                _mm256_slli_epi64(_Comb, 58),
+                                _mm256_slli_epi64(
+                                        _mm256_and_si256(
+                                                _E, _mm256_set1_epi64x(0xFF)),
+                                        50)));
+                _W = _mm256_or_si256(_W, _mm256_and_si256(
+                        _LaneMask4(_X._Signs, _I),
+                        _mm256_set1_epi64x(static_cast<long long>(
+                                static_cast<uint64_t>(1) << 63))));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(_Out + _I),
+                                    _W);
+                }
+        for (int _K = 0; _X._Specials != 0 && _K != _I; ++_K)
+                {
+                if ((_X._Specials >> _K & 1) != 0)
+                        { _EncodeLanes(_X, _K, _K + 1, _Out); }
+                }
+        _EncodeLanes(_X, _I, _Count, _Out);
+        }
+
+// Packed fields of up to 16 bytes.  The field is loaded right aligned
+// into a vector, whose nibbles are checked against 9 all at once.  Read
+// backwards from the last byte, the bytes hold the sign nibble and then
+// the digits, so group _K is the 12 bits at bit 12 _K + 4; pshufb moves
+// the two bytes that hold them into a 16-bit lane, and a multiply by 16
+// in the odd lanes and a shift right by 4 in all of them align them.
+_DEC_AVX2 static unsigned _ReadPackedAVX2(const uint8_t * _F,
+                                          std::size_t _Length,
+                                          unsigned * _G)
+        {
+        if (_Length > 16)
+                { return _ReadPackedPortable(_F, _Length, _G); }
+        uint8_t _Buf[16] = { 0 };
+        memcpy(_Buf + 16 - _Length, _F, _Length);
+        const __m128i _B = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(_Buf));
+
+        const __m128i _Nibble = _mm_set1_epi8(0xF);
+        const __m128i _Nine = _mm_set1_epi8(9);
+        const __m128i _Lo = _mm_and_si128(_B, _Nibble);
+        const __m128i _Hi = _mm_and_si128(_mm_srli_epi16(_B, 4), _Nibble);
+        // every nibble but the sign is a digit
+        const __m128i _Digits = _mm_set_epi8(0, -1, -1, -1, -1, -1, -1, -1,
+                                             -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i _Bad = _mm_or_si128(
+                _mm_cmpgt_epi8(_Hi, _Nine),
+                _mm_and_si128(_mm_cmpgt_epi8(_Lo, _Nine), _Digits));
+        if (_mm_movemask_epi8(_Bad) != 0)
+                { return 0; }
+
+        const __m256i _Pairs = _mm256_setr_epi8(
+                15, 14, 13, 12, 12, 11, 10, 9, 9, 8, 7, 6, 6, 5, 4, 3,
+                3, 2, 1, 0, 0, -128, -128, -128, -128, -128, -128, -128,
+                -128, -128, -128, -128);
+        const __m256i _Align = _mm256_setr_epi16(1, 16, 1, 16, 1, 16, 1, 16,
+                                                 1, 16, 1, 16, 1, 16, 1, 16);
+        const __m256i _W = _mm256_srli_epi16(_mm256_mullo_epi16(
+                _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_B), _Pairs),
+                _Align), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_G),
+                            _mm256_cvtepu16_epi32(
+                                    _mm256_castsi256_si128(_W)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_G + 8),
+                            _mm256_cvtepu16_epi32(
+                                    _mm256_extracti128_si256(_W, 1)));
+        return _Buf[15] & 0xF;
+        }
+
+static const _SimdKernels _AVX2 = {
+        _AddAVX2, _CompareAVX2, _MinMaxAVX2, _DecodeAVX2, _EncodeAVX2,
+        _ReadPackedAVX2
+};
+
+// Eight values at a time, with the bitmaps as lane masks.
+_DEC_AVX512 static inline __m512i _Signed8(const _SimdOperand & _X, int _I)
+        {
+        const __m512i _C = _mm512_loadu_si512(_X._Coeff + _I);
+        return _mm512_mask_sub_epi64(
+                _C, static_cast<__mmask8>(_X._Signs >> _I),
+                _mm512_setzero_si512(), _C);
+        }
+
+_DEC_AVX512 static inline __m512i _Exp8(const _SimdOperand & _X, int _I)
+        {
+        return _mm512_cvtepi16_epi64(_mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(_X._Exp + _I)));
+        }
+
+_DEC_AVX512 static inline __mmask8 _Aligned8(const _SimdOperand & _A,
+                                             const _SimdOperand & _B,
+                                             int _I, bool _Normal)
+        {
+        const __m512i _EA = _Exp8(_A, _I);
+        __mmask8 _Ok = _mm512_cmpeq_epi64_mask(_EA, _Exp8(_B, _I)) &
+                       static_cast<__mmask8>(
+                               ~((_A._Specials | _B._Specials) >> _I));
+        if (_Normal)
+                {
+                _Ok &= _mm512_cmpge_epi64_mask(_EA,
+                                               _mm512_set1_epi64(_SimdEmin));
+                }
+        return _Ok;
+        }
+
+_DEC_AVX512 static uint64_t _AddAVX512(const _SimdOperand & _A,
+                                       const _SimdOperand & _B, int _Count,
+                                       uint64_t * _Coeff, uint64_t & _Signs)
+        {
+        const __m512i _Zero = _mm512_setzero_si512();
+        const __m512i _Limit = _mm512_set1_epi64(
+                static_cast<long long>(_SimdLimit));
+        uint64_t _Done = 0;
+        _Signs = 0;
+        int _I = 0;
+        for (; _I + 8 <= _Count; _I += 8)
+                {
+                const __m512i _S = _mm512_add_epi64(_Signed8(_A, _I),
+                                                    _Signed8(_B, _I));
+                const __m512i _M = _mm512_abs_epi64(_S);
+                _mm512_storeu_si512(_Coeff + _I, _M);
+                const __mmask8 _Ok = _Aligned8(_A, _B, _I, true) &
+                                     _mm512_cmpneq_epi64_mask(_S, _Zero) &
+                                     _mm512_cmplt_epi64_mask(_M, _Limit);
+                _Signs |= static_cast<uint64_t>(
+                        _mm512_cmplt_epi64_mask(_S, _Zero)) << _I;
+                _Done |= static_cast<uint64_t>(_Ok) << _I;
+                }
+        return _Done | _AddLanes(_A, _B, _I, _Count, _Coeff, _Signs);
+        }
+
+_DEC_AVX512 static uint64_t _CompareAVX512(const _SimdOperand & _A,
+                                           const _SimdOperand & _B,
+                                           int _Count, int8_t * _Out)
+        {
+        uint64_t _Done = 0;
+        int _I = 0;
+        for (; _I + 8 <= _Count; _I += 8)
+                {
+                const __m512i _VA = _Signed8(_A, _I), _VB = _Signed8(_B, _I);
+                const unsigned _Lt = _mm512_cmplt_epi64_mask(_VA, _VB);
+                const unsigned _Gt = _mm512_cmpgt_epi64_mask(_VA, _VB);
+                for (int _K = 0; _K != 8; ++_K)
+                        {
+                        _Out[_I + _K] = static_cast<int8_t>(
+                                static_cast<int>(_Gt >> _K & 1) -
+                                static_cast<int>(_Lt >> _K & 1));
+                        }
+                _Done |= static_cast<uint64_t>(
+                        _Aligned8(_A, _B, _I, false)) << _I;
+                }
+        return _Done | _CompareLanes(_A, _B, _I, _Count, _Out);
+        }
+
+_DEC_AVX512 static uint64_t _MinMaxAVX512(const _SimdOperand & _A,
+                                          const _SimdOperand & _B,
+                                          int _Count, bool _Max,
+                                          uint64_t & _FromB)
+        {
+        uint64_t _Done = 0;
+        _FromB = 0;
+        int _I = 0;
+        for (; _I + 8 <= _Count; _I += 8)
+                {
+                const __m512i _VA = _Signed8(_A, _I), _VB = _Signed8(_B, _I);
+                const __mmask8 _Pick = _Max ?
+                        _mm512_cmpgt_epi64_mask(_VB, _VA) :
+                        _mm512_cmpgt_epi64_mask(_VA, _VB);
+                const __mmask8 _Tie = _mm512_cmpeq_epi64_mask(_VA, _VB) &
+                        static_cast<__mmask8>((_A._Signs ^ _B._Signs) >> _I);
+                _FromB |= static_cast<uint64_t>(_Pick) << _I;
+                _Done |= static_cast<uint64_t>(
+                        _Aligned8(_A, _B, _I, true) &
+                        static_cast<__mmask8>(~_Tie)) << _I;
+                }
+        return _Done | _MinMaxLanes(_A, _B, _I, _Count, _Max, _FromB);
+        }
+
+_DEC_AVX512 static inline __m256i _Units8(__m256i _Thousands)
+        {
+        return _mm256_mullo_epi32(_mm256_srli_epi32(_Thousands, 3),
+                                  _mm256_set1_epi32(_Inverse125));
+        }
+
+_DEC_AVX512 static inline __m256i _Gather8(const uint32_t * _Table,
+                                           __m512i _W, int _K)
+        {
+        const __m512i _D = _mm512_and_si512(
+                _mm512_srl_epi64(_W, _mm_cvtsi32_si128(10 * _K)),
+                _mm512_set1_epi64(0x3FF));
+        return _mm512_i64gather_epi32(_D, _Table, 4);
+        }
+
+_DEC_AVX512 static uint64_t _DecodeAVX512(const uint64_t * _In, int _Count,
+                                          uint64_t * _Coeff, int16_t * _Exp,
+                                          uint64_t & _Signs)
+        {
+        const __m512i _Inf = _mm512_set1_epi64(0x78LL << 56);
+        const __m512i _Large = _mm512_set1_epi64(0x18);
+        uint64_t _Specials = 0;
+        _Signs = 0;
+        int _I = 0;
+        for (; _I + 8 <= _Count; _I += 8)
+                {
+                const __m512i _W = _mm512_loadu_si512(_In + _I);
+                const __m256i _Hi = _mm256_add_epi32(
+                        _mm256_add_epi32(_Gather8(DPD2BINM, _W, 4),
+                                         _Gather8(DPD2BINK, _W, 3)),
+                        _Units8(_Gather8(DPD2BINK, _W, 2)));
+                const __m256i _Lo = _Units8(_mm256_add_epi32(
+                        _Gather8(DPD2BINM, _W, 1), _Gather8(DPD2BINK, _W, 0)));
+
+                const __m512i _Comb = _mm512_and_si512(
+                        _mm512_srli_epi64(_W, 58), _mm512_set1_epi64(0x1F));
+                const __mmask8 _IsLarge = _mm512_cmpeq_epi64_mask(
+                        _mm512_and_si512(_Comb, _Large), _Large);
+                const __m512i _Msd = _mm512_mask_blend_epi64(
+                        _IsLarge,
+                        _mm512_and_si512(_Comb, _mm512_set1_epi64(7)),
+                        _mm512_or_si512(
+                                _mm512_and_si512(_Comb, _mm512_set1_epi64(1)),
+                                _mm512_set1_epi64(8)));
+                const __m512i _ExpHi = _mm512_mask_blend_epi64(
+                        _IsLarge, _mm512_srli_epi64(_Comb, 3),
+                        _mm512_and_si512(_mm512_srli_epi64(_Comb, 1),
+                                         _mm512_set1_epi64(3)));
+                const __m512i _E = _mm512_sub_epi64(
+                        _mm512_or_si512(
+                                _mm512_slli_epi64(_ExpHi, 8),
+                                _mm512_and_si512(_mm512_srli_epi64(_W, 50),
+                                                 _mm512_set1_epi64(0xFF))),
+                        _mm512_set1_epi64(_Layout64::_Bias));
+
+                const __m512i _C = _mm512_add_epi64(
+                        _mm512_add_epi64(
+                                _mm512_mul_epu32(_mm512_cvtepu32_epi64(_Hi),
+                                                 _mm512_set1_epi64(1000000)),
+                                _mm512_cvtepu32_epi64(_Lo)),
+                        _mm512_mul_epu32(
+                                _mm512_mul_epu32(_Msd,
+                                                 _mm512_set1_epi64(1000000)),
+                                _mm512_set1_epi64(1000000000)));
+                _mm512_storeu_si512(_Coeff + _I, _C);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(_Exp + _I),
+                                 _mm512_cvtepi64_epi16(_E));
+                _Signs |= static_cast<uint64_t>(_mm512_cmplt_epi64_mask(
+                        _W, _mm512_setzero_si512())) << _I;
+                _Specials |= static_cast<uint64_t>(_mm512_cmpeq_epi64_mask(
+                        _mm512_and_si512(_W, _Inf), _Inf)) << _I;
+                }
+        for (int _K = 0; _Specials != 0 && _K != _I; ++_K)
+                {
+                if ((_Specials >> _K & 1) != 0)
+                        {
+                        _DecodeLanes(_In, _K, _K + 1, _Coeff, _Exp,
+                                     _Signs);
+                        }
+                }
+        return _Specials | _DecodeLanes(_In, _I, _Count, _Coeff, _Exp, _Signs);
+        }
+
+_DEC_AVX512 static inline __m512i _Div1000x8(__m512i _X)
+        {
+        return _mm512_srli_epi64(
+                _mm512_mul_epu32(_X, _mm512_set1_epi64(_Div1000)), 38);
+        }
+
+_DEC_AVX512 static inline __m512i _Mod1000x8(__m512i _X, __m512i _Div)
+        {
+        return _mm512_sub_epi64(
+                _X, _mm512_mul_epu32(_Div, _mm512_set1_epi64(1000)));
+        }
+
+_DEC_AVX512 static inline __m512i _Declet8(__m512i _G)
+        {
+        const __m256i _D = _mm512_mask_i64gather_epi32(
+                _mm256_setzero_si256(),
+                _mm512_cmpgt_epi64_mask(_G, _mm512_setzero_si512()),
+                _mm512_sub_epi64(_mm512_add_epi64(_G, _G),
+                                 _mm512_set1_epi64(2)),
+                BIN2DPD, 1);
+        return _mm512_cvtepu32_epi64(_mm256_srli_epi32(_D, 16));
+        }
+
+_DEC_AVX512 static void _EncodeAVX512(const _SimdOperand & _X, int _Count,
+                                      uint64_t * _Out)
+        {
+        const __m512d _Two52 = _mm512_set1_pd(4503599627370496.0);
+        const __m512i _Bias52 = _mm512_castpd_si512(_Two52);
+        const __m512i _Billion = _mm512_set1_epi64(1000000000);
+        const __m512i _One = _mm512_set1_epi64(1);
+        int _I = 0;
+        for (; _I + 8 <= _Count; _I += 8)
+                {
+                const __m512i _C = _mm512_loadu_si512(_X._Coeff + _I);
+                const __m512d _CH = _mm512_sub_pd(_mm512_castsi512_pd(
+                        _mm512_or_si512(_mm512_srli_epi64(_C, 32), _Bias52)),
+                        _Two52);
+                const __m512d _CL = _mm512_sub_pd(_mm512_castsi512_pd(
+                        _mm512_or_si512(
+                                _mm512_and_si512(_C, _mm512_set1_epi64(
+                                        0xFFFFFFFFLL)),
+                                _Bias52)),
+                        _Two52);
+                const __m512d _Est = _mm512_roundscale_pd(_mm512_mul_pd(
+                        _mm512_add_pd(_mm512_mul_pd(
+                                _CH, _mm512_set1_pd(4294967296.0)), _CL),
+                        _mm512_set1_pd(1e-9)),
+                        _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+                __m512i _Q = _mm512_sub_epi64(_mm512_castpd_si512(
+                        _mm512_add_pd(_Est, _Two52)), _Bias52);
+                __m512i _R = _mm512_sub_epi64(_C,
+                                              _mm512_mul_epu32(_Q, _Billion));
+                const __mmask8 _Under = _mm512_cmplt_epi64_mask(
+                        _R, _mm512_setzero_si512());
+                _Q = _mm512_mask_sub_epi64(_Q, _Under, _Q, _One);
+                _R = _mm512_mask_add_epi64(_R, _Under, _R, _Billion);
+                const __mmask8 _Over = _mm512_cmpge_epi64_mask(_R, _Billion);
+                _Q = _mm512_mask_add_epi64(_Q, _Over, _Q, _One);
+                _R = _mm512_mask_sub_epi64(_R, _Over, _R, _Billion);
+
+                const __m512i _R1 = _Div1000x8(_R), _R2 = _Div1000x8(_R1);
+                const __m512i _Q1 = _Div1000x8(_Q), _Msd = _Div1000x8(_Q1);
+                __m512i _W = _mm512_or_si512(
+                        _mm512_or_si512(
+                                _Declet8(_Mod1000x8(_R, _R1)),
+                                _mm512_slli_epi64(
+                                        _Declet8(_Mod1000x8(_R1, _R2)), 10)),
+                        _mm512_or_si512(
+                                _mm512_slli_epi64(_Declet8(_R2), 20),
+                                _mm512_or_si512(
+                                        _mm512_slli_epi64(_Declet8(
+                                                _Mod1000x8(_Q, _Q1)), 30),
+                                        _mm512_slli_epi64(_Declet8(
+                                                _Mod1000x8(_Q1, _Msd)), 40))));
+
+                const __m512i _E = _mm512_add_epi64(
+                        _Exp8(_X, _I), _mm512_set1_epi64(_Layout64::_Bias));
+                const __m512i _ExpHi = _mm512_srli_epi64(_E, 8);
+                const __m512i _Comb = _mm512_mask_blend_epi64(
+                        _mm512_cmplt_epi64_mask(_Msd, _mm512_set1_epi64(8)),
+                        _mm512_or_si512(
+                                _mm512_set1_epi64(0x18),
+                                _mm512_or_si512(
+                                        _mm512_slli_epi64(_ExpHi, 1),
+                                        _mm512_and_si512(_Msd, _One))),
+                        _mm512_or_si512(_mm512_slli_epi64(_ExpHi, 3), _Msd));
+                _W = _mm512_or_si512(
+                        _W,
+                        _mm512_or_si512(
+                                _mm512_slli_epi64(_Comb, 58),
+                                _mm512_slli_epi64(
+                                        _mm512_and_si512(
+                                                _E, _mm512_set1_epi64(0xFF)),
+                                        50)));
+                _W = _mm512_mask_or_epi64(
+                        _W, static_cast<__mmask8>(_X._Signs >> _I), _W,
+                        _mm512_set1_epi64(static_cast<long long>(
+                                static_cast<uint64_t>(1) << 63)));
+                _mm512_storeu_si512(_Out + _I, _W);
+                }
+        for (int _K = 0; _X._Specials != 0 && _K != _I; ++_K)
+                {
+                if ((_X._Specials >> _K & 1) != 0)
+                        { _EncodeLanes(_X, _K, _K + 1, _Out); }
+                }
+        _EncodeLanes(_X, _I, _Count, _Out);
+        }
+
+static const _SimdKernels _AVX512 = {
+        _AddAVX512, _CompareAVX512, _MinMaxAVX512, _DecodeAVX512,
+        _EncodeAVX512, _ReadPackedAVX2
+};
+
+// the best level the processor supports
+static _SimdLevel _SupportedLevel()
+        {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+                { return _SimdAVX512; }
+        if (__builtin_cpu_supports("avx2"))
+                { return _SimdAVX2; }
+        return _SimdPortable;
+        }
+
+#else
+
+static _SimdLevel _SupportedLevel()
+        { return _SimdPortable; }
+
+#endif /* defined(_DEC_HAS_X86_SIMD) */
+
+static const _SimdKernels & _KernelsOf(_SimdLevel _Level)
+        {
+#if defined(_DEC_HAS_X86_SIMD)
+        if (_Level == _SimdAVX512)
+                { return _AVX512; }
+        if (_Level == _SimdAVX2)
+                { return _AVX2; }
+#endif /* defined(_DEC_HAS_X86_SIMD) */
+        return _Portable;
+        }
+
+// Chosen on first use.  Threads that race to choose them store the same
+// kernels.
+static const _SimdKernels * _Selected = 0;
+
+const _SimdKernels & _GetSimdKernels()
+        {
+        if (_Selected == 0)
+                { _Selected = &_KernelsOf(_SupportedLevel()); }
+        return *_Selected;
+        }
+
+_SimdLevel _SetSimdLevel(_SimdLevel _Level)
+        {
+        const _SimdLevel _Max = _SupportedLevel();
+        if (_Level > _Max)
+                { _Level = _Max; }
+        _Selected = &_KernelsOf(_Level);
+        return _Level;
+        }
+
+} // namespace decimal
+} // namespace std
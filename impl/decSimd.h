@@ -0,0 +1,114 @@
+/* ------------------------------------------------------------------ */
+/* decSimd.h header                                                   */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+// Block kernels of the operations on decimal64 columns (see deccolumn),
+// in portable C++ and, where the compiler and processor allow it, with
+// AVX2 and AVX-512 instructions.  Each kernel works on a block of up to
+// 64 values, given as the coefficients, the exponents and the bitmap
+// words of the signs and of the specials of each operand.  It decides
+// the values whose operands are finite and have the same exponent, and
+// whose result is one of the operands or their exact nonzero sum with
+// a normal exponent, and returns a mask with bit _I set for each value
+// _I it decided.  The caller goes through the general path for the
+// others.
+//
+// The conversions between the DPD encodings of decimal64 and the arrays
+// of a column convert every value of their block, decoding its declets
+// many at a time through the 32-bit tables of decDPD.h.
+//
+// The reader of packed decimal fields (see decpacked) splits the bytes
+// of a field into the 12-bit BCD groups that index the BCD2DPD table.
+//
+// The portable kernels are the reference for the others, which decide
+// the same values and give the same results.
+
+#ifndef _DECSIMD_H
+#define _DECSIMD_H
+
+#include "decimal"
+
+namespace std {
+namespace decimal {
+
+// one operand of a block
+struct _SimdOperand {
+        const uint64_t * _Coeff;
+        const int16_t *  _Exp;
+        uint64_t         _Signs;
+        uint64_t         _Specials;
+};
+
+// _A + _B, where the signs of _B have been inverted for a subtraction;
+// stores the magnitudes in _Coeff and their signs in _Signs
+typedef uint64_t (*_SimdAddFn)(const _SimdOperand & _A,
+                               const _SimdOperand & _B, int _Count,
+                               uint64_t * _Coeff, uint64_t & _Signs);
+
+// -1, 0 or 1 in _Out as _A is less than, equal to or greater than _B
+typedef uint64_t (*_SimdCompareFn)(const _SimdOperand & _A,
+                                   const _SimdOperand & _B, int _Count,
+                                   int8_t * _Out);
+
+// the smaller (or with _Max, the larger) of _A and _B; stores a mask of
+// the values taken from _B in _FromB
+typedef uint64_t (*_SimdMinMaxFn)(const _SimdOperand & _A,
+                                  const _SimdOperand & _B, int _Count,
+                                  bool _Max, uint64_t & _FromB);
+
+// Unpacks the DPD encodings _In into the coefficients and exponents of
+// a block, and its sign bits into _Signs; returns its specials bitmap.
+typedef uint64_t (*_SimdDecodeFn)(const uint64_t * _In, int _Count,
+                                  uint64_t * _Coeff, int16_t * _Exp,
+                                  uint64_t & _Signs);
+
+// packs the values of _X into DPD encodings in _Out
+typedef void (*_SimdEncodeFn)(const _SimdOperand & _X, int _Count,
+                              uint64_t * _Out);
+
+// the 12-bit BCD groups a packed field is read into
+static const int _SimdGroups = 16;
+
+// Reads the digits of a packed field of _Length bytes, at most 22, into
+// the _SimdGroups groups _G, least significant first.  Returns the sign
+// nibble, or zero if a digit is above 9.
+typedef unsigned (*_SimdPackedFn)(const uint8_t * _F, std::size_t _Length,
+                                  unsigned * _G);
+
+struct _SimdKernels {
+        _SimdAddFn     _Add;
+        _SimdCompareFn _Compare;
+        _SimdMinMaxFn  _MinMax;
+        _SimdDecodeFn  _Decode;
+        _SimdEncodeFn  _Encode;
+        _SimdPackedFn  _ReadPacked;
+};
+
+// the instruction sets of the kernels
+enum _SimdLevel {
+        _SimdPortable,
+        _SimdAVX2,
+        _SimdAVX512
+};
+
+// The kernels in use, the best the processor supports unless set
+// otherwise.  _SetSimdLevel selects the kernels of a lower level, for
+// testing against the portable ones, and returns the level selected.
+const _SimdKernels & _GetSimdKernels();
+_SimdLevel _SetSimdLevel(_SimdLevel _Level);
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECSIMD_H */
@@ -0,0 +1,124 @@
+/* ------------------------------------------------------------------ */
+/* decThread.cpp source file                                          */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <vector>
+
+#include "impl/decThread.h"
+
+#ifdef _DEC_HAS_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif /* def _DEC_HAS_PTHREADS */
+
+namespace std {
+namespace decimal {
+
+#ifdef _DEC_HAS_PTHREADS
+
+// shared state of one _ParallelFor call
+struct _ParallelState {
+        _ParallelTask   _Task;
+        void *          _Arg;
+        std::size_t     _Count;
+        std::size_t     _Next;
+        pthread_mutex_t _Lock;
+
+        bool _NextIndex(std::size_t & _Idx)
+                {
+                pthread_mutex_lock(&_Lock);
+                _Idx = _Next;
+                if (_Next != _Count)
+                        { ++_Next; }
+                pthread_mutex_unlock(&_Lock);
+                return _Idx != _Count;
+                }
+};
+
+extern "C" void * _DecParallelWorker(void * _Ptr)
+        {
+        _ParallelState * _State = static_cast<_ParallelState *>(_Ptr);
+        std::size_t _Idx;
+        while (_State->_NextIndex(_Idx))
+                { _State->_Task(_State->_Arg, _Idx); }
+        return 0;
+        }
+
+unsigned _ThreadCount(unsigned _Requested)
+        {
+        if (_Requested != 0)
+                { return _Requested; }
+        const long _Online = sysconf(_SC_NPROCESSORS_ONLN);
+        return _Online > 0 ? static_cast<unsigned>(_Online) : 1;
+        }
+
+void _ParallelFor(std::size_t _Count,
+                  _ParallelTask _Task,
+                  void * _Arg,
+                  unsigned _Threads)
+        {
+        _Threads = _ThreadCount(_Threads);
+        if (_Threads > _Count)
+                { _Threads = static_cast<unsigned>(_Count); }
+
+        if (_Threads <= 1)
+                {
+                for (std::size_t _Idx = 0; _Idx != _Count; ++_Idx)
+                        { _Task(_Arg, _Idx); }
+                return;
+                }
+
+        _ParallelState _State;
+        _State._Task = _Task;
+        _State._Arg = _Arg;
+        _State._Count = _Count;
+        _State._Next = 0;
+        pthread_mutex_init(&_State._Lock, 0);
+
+        // If a thread cannot be created, the remaining threads (at
+        // least the calling one) simply take on more of the work.
+        std::vector<pthread_t> _Workers(_Threads - 1);
+        std::size_t _Started = 0;
+        for (; _Started != _Workers.size(); ++_Started)
+                {
+                if (pthread_create(&_Workers[_Started], 0,
+                                   _DecParallelWorker, &_State) != 0)
+                        { break; }
+                }
+
+        _DecParallelWorker(&_State);
+
+        for (std::size_t _Idx = 0; _Idx != _Started; ++_Idx)
+                { pthread_join(_Workers[_Idx], 0); }
+        pthread_mutex_destroy(&_State._Lock);
+        }
+
+#else
+
+unsigned _ThreadCount(unsigned)
+        { return 1; }
+
+void _ParallelFor(std::size_t _Count,
+                  _ParallelTask _Task,
+                  void * _Arg,
+                  unsigned)
+        {
+        for (std::size_t _Idx = 0; _Idx != _Count; ++_Idx)
+                { _Task(_Arg, _Idx); }
+        }
+
+#endif /* def _DEC_HAS_PTHREADS */
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,47 @@
+/* ------------------------------------------------------------------ */
+/* decThread.h header                                                 */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#ifndef _DECTHREAD_H
+#define _DECTHREAD_H
+
+#include <cstddef>
+
+// Configuration macros for the decNumber++ library.
+#include "impl/decConfig.h"
+
+namespace std {
+namespace decimal {
+
+// a task for _ParallelFor: called once for every index in [0, _Count)
+typedef void (*_ParallelTask)(void * _Arg, std::size_t _Idx);
+
+// Returns the number of threads to use when _Requested threads were
+// asked for; zero requests one thread per online processor.  Without
+// _DEC_HAS_PTHREADS, this is always one.
+unsigned _ThreadCount(unsigned _Requested);
+
+// Runs _Task(_Arg, _Idx) for every _Idx in [0, _Count) on up to
+// _Threads threads (see _ThreadCount), and returns when all calls
+// have completed.  Indices are handed out one at a time, so tasks of
+// uneven cost balance themselves.  The calling thread takes part.
+void _ParallelFor(std::size_t _Count,
+                  _ParallelTask _Task,
+                  void * _Arg,
+                  unsigned _Threads);
+
+} // namespace decimal
+} // namespace std
+
+#endif /* ndef _DECTHREAD_H */
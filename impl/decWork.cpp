@@ -0,0 +1,319 @@
+/* ------------------------------------------------------------------ */
+/* decWork.cpp source file                                            */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include "decwork"
+
+extern "C" {
+#include "decNumberLocal.h"
+}
+
+namespace std {
+namespace decimal {
+
+// the number of digits of a coefficient
+static int _Digits(uint64_t _C)
+        {
+        int _D = 1;
+        while (_D < 20 && _C >= _KernelPow10[_D])
+                { ++_D; }
+        return _D;
+        }
+
+static int _Digits(const _Uint128 & _C)
+        {
+        int _D = 1;
+        while (_D < 35 && !(_C < _KernelPow10W[_D]))
+                { ++_D; }
+        return _D;
+        }
+
+// the units of a decNumber holding a coefficient, least significant
+// first, and back
+static void _SetUnits(uint64_t _C, decNumber & _N)
+        {
+        for (int _I = 0; _I != D2U(_N.digits); ++_I)
+                {
+                _N.lsu[_I] = static_cast<Unit>(_C % (DECDPUNMAX + 1));
+                _C /= DECDPUNMAX + 1;
+                }
+        }
+
+static void _SetUnits(_Uint128 _C, decNumber & _N)
+        {
+        for (int _I = 0; _I != D2U(_N.digits); ++_I)
+                {
+                _N.lsu[_I] = static_cast<Unit>(
+                        _DivSmall(_C, DECDPUNMAX + 1));
+                }
+        }
+
+static void _GetUnits(const decNumber & _N, uint64_t & _C)
+        {
+        _C = 0;
+        for (int _I = D2U(_N.digits) - 1; _I >= 0; --_I)
+                { _C = _C * (DECDPUNMAX + 1) + _N.lsu[_I]; }
+        }
+
+static void _GetUnits(const decNumber & _N, _Uint128 & _C)
+        {
+        _C = _MakeUint128(0, 0);
+        for (int _I = D2U(_N.digits) - 1; _I >= 0; --_I)
+                { _C = _Add64(_MulSmall(_C, DECDPUNMAX + 1), _N.lsu[_I]); }
+        }
+
+// An unpacked value as a decNumber, as decimal64ToNumber or
+// decimal128ToNumber gives its encoding, and a result of an operation
+// under the context of the format, which fits the format, unpacked.
+template <class _Native>
+static void _ToNumber(const _Native & _V, decNumber & _N)
+        {
+        _N.bits = _V._Sign ? DECNEG : 0;
+        _N.exponent = _V._Kind == _NativeFinite ? _V._Exp : 0;
+        switch (_V._Kind)
+                {
+                case _NativeInf:
+                        _N.bits |= DECINF;
+                        _N.digits = 1;
+                        _N.lsu[0] = 0;
+                        return;
+                case _NativeQNaN:
+                        _N.bits |= DECNAN;
+                        break;
+                case _NativeSNaN:
+                        _N.bits |= DECSNAN;
+                        break;
+                default:
+                        break;
+                }
+        _N.digits = _Digits(_V._Coeff);
+        _SetUnits(_V._Coeff, _N);
+        }
+
+template <class _M>
+static void _FromNumber(const decNumber & _N, typename _M::_Native & _V)
+        {
+        _V._Sign = (_N.bits & DECNEG) != 0;
+        _V._Exp = 0;
+        if (_N.bits & DECINF)
+                {
+                _V._Kind = _NativeInf;
+                _V._Coeff = typename _M::_Coeff();
+                return;
+                }
+        if (_N.bits & DECNAN)
+                { _V._Kind = _NativeQNaN; }
+        else if (_N.bits & DECSNAN)
+                { _V._Kind = _NativeSNaN; }
+        else
+                {
+                _V._Kind = _NativeFinite;
+                _V._Exp = _N.exponent;
+                }
+        _GetUnits(_N, _V._Coeff);
+        }
+
+// the result of the operation through decNumber
+template <class _M>
+static void _Slow(_WorkOperation _Op, const typename _M::_Native & _A,
+                  const typename _M::_Native & _B, typename _M::_Native & _R)
+        {
+        typename _M::_Tr::_Context _Ctxt(false);
+        decNumber _X, _Y, _Z;
+        _ToNumber(_A, _X);
+        _ToNumber(_B, _Y);
+        switch (_Op)
+                {
+                case _WorkAdd:
+                        decNumberAdd(&_Z, &_X, &_Y, &_Ctxt);
+                        break;
+                case _WorkSub:
+                        decNumberSubtract(&_Z, &_X, &_Y, &_Ctxt);
+                        break;
+                case _WorkMul:
+                        decNumberMultiply(&_Z, &_X, &_Y, &_Ctxt);
+                        break;
+                default:
+                        decNumberDivide(&_Z, &_X, &_Y, &_Ctxt);
+                        break;
+                }
+        _FromNumber<_M>(_Z, _R);
+        }
+
+#if defined(_DEC_HAS_INT128)
+
+// The rounded product of two finite decimal64 values, when it is a
+// normal number: the 128-bit product of the coefficients is cut to 16
+// digits and rounded as decNumberMultiply rounds it.
+static bool _RoundedProduct(const _Native64 & _A, const _Native64 & _B,
+                            rounding _Mode, _Native64 & _R)
+        {
+        typedef _KernelFmt<decimal64> _M;
+        const _NativeUint128 _P =
+                static_cast<_NativeUint128>(_A._Coeff) * _B._Coeff;
+        const _NativeUint128 _Pow16 = _KernelPow10[16];
+        if (_P < _Pow16)
+                { return false; }
+
+        // the number of digits dropped
+        int _D = 1;
+        _NativeUint128 _Low = 1;
+        while (_P >= _Pow16 * 10 * _Low)
+                {
+                _Low *= 10;
+                ++_D;
+                }
+        _NativeUint128 _Q = _P / _Low;
+        const _NativeUint128 _Rem = _P % _Low;
+        const unsigned _First = static_cast<unsigned>(_Q % 10);
+        _Q /= 10;
+        uint64_t _C = static_cast<uint64_t>(_Q);
+        int _E = _A._Exp + _B._Exp + _D;
+        _R._Sign = _A._Sign ^ _B._Sign;
+        if (_RoundsUp(_Mode, _R._Sign, static_cast<unsigned>(_C % 10), _First,
+                      _Rem != 0))
+                {
+                if (++_C == _KernelPow10[16])
+                        {
+                        _C = _KernelPow10[15];
+                        ++_E;
+                        }
+                }
+        if (_E < _M::_Emin || _E > _M::_MaxExp)
+                { return false; }
+        _R._Kind = _NativeFinite;
+        _R._Coeff = _C;
+        _R._Exp = _E;
+        return true;
+        }
+
+// The rounded quotient of two finite nonzero decimal64 values, when it
+// is inexact and a normal number: the dividend is scaled so that the
+// integer quotient has 16 or 17 digits, and the remainder gives the
+// digits dropped.  An exact quotient is left to decNumberDivide, which
+// chooses its exponent.
+static bool _RoundedQuotient(const _Native64 & _A, const _Native64 & _B,
+                             rounding _Mode, _Native64 & _R)
+        {
+        typedef _KernelFmt<decimal64> _M;
+        if (_A._Coeff == 0 || _B._Coeff == 0)
+                { return false; }
+        const int _K = 16 + _Digits(_B._Coeff) - _Digits(_A._Coeff);
+        if (_K < 0)
+                { return false; }
+        _NativeUint128 _N = _A._Coeff;
+        for (int _I = 0; _I != _K; ++_I)
+                { _N *= 10; }
+        _NativeUint128 _Q = _N / _B._Coeff;
+        _NativeUint128 _Rem = _N % _B._Coeff;
+        int _E = _A._Exp - _B._Exp - _K;
+        unsigned _First;
+        bool _Sticky;
+        if (_Q >= _KernelPow10[16])
+                {
+                _First = static_cast<unsigned>(_Q % 10);
+                _Sticky = _Rem != 0;
+                _Q /= 10;
+                ++_E;
+                }
+        else
+                {
+                _Rem *= 10;
+                _First = static_cast<unsigned>(_Rem / _B._Coeff);
+                _Sticky = _Rem % _B._Coeff != 0;
+                }
+        if (_First == 0 && !_Sticky)
+                { return false; }
+        uint64_t _C = static_cast<uint64_t>(_Q);
+        _R._Sign = _A._Sign ^ _B._Sign;
+        if (_RoundsUp(_Mode, _R._Sign, static_cast<unsigned>(_C % 10), _First,
+                      _Sticky))
+                {
+                if (++_C == _KernelPow10[16])
+                        {
+                        _C = _KernelPow10[15];
+                        ++_E;
+                        }
+                }
+        if (_E < _M::_Emin || _E > _M::_MaxExp)
+                { return false; }
+        _R._Kind = _NativeFinite;
+        _R._Coeff = _C;
+        _R._Exp = _E;
+        return true;
+        }
+
+#endif /* defined(_DEC_HAS_INT128) */
+
+void _WorkSlow(_WorkOperation _Op, const _Native64 & _A,
+               const _Native64 & _B, _Native64 & _R)
+        {
+#if defined(_DEC_HAS_INT128)
+        if (_A._Kind == _NativeFinite && _B._Kind == _NativeFinite &&
+            (_Op == _WorkMul || _Op == _WorkDiv))
+                {
+                const rounding _Mode =
+                        static_cast<rounding>(fe_dec_getround());
+                _Native64 _T;
+                if (_Op == _WorkMul ? _RoundedProduct(_A, _B, _Mode, _T) :
+                                      _RoundedQuotient(_A, _B, _Mode, _T))
+                        {
+                        _R = _T;
+                        return;
+                        }
+                }
+#endif /* defined(_DEC_HAS_INT128) */
+        _Slow<_KernelFmt<decimal64> >(_Op, _A, _B, _R);
+        }
+
+void _WorkSlow(_WorkOperation _Op, const _Native128 & _A,
+               const _Native128 & _B, _Native128 & _R)
+        { _Slow<_KernelFmt<decimal128> >(_Op, _A, _B, _R); }
+
+template <class _M>
+static int _Compare(const typename _M::_Native & _A,
+                    const typename _M::_Native & _B)
+        {
+        if (_A._Kind == _NativeQNaN || _A._Kind == _NativeSNaN ||
+            _B._Kind == _NativeQNaN || _B._Kind == _NativeSNaN)
+                { return 2; }
+        const bool _IA = _A._Kind == _NativeInf;
+        const bool _IB = _B._Kind == _NativeInf;
+        if (_IA || _IB)
+                {
+                const int _RA = _IA ? (_A._Sign ? -1 : 1) : 0;
+                const int _RB = _IB ? (_B._Sign ? -1 : 1) : 0;
+                return _RA < _RB ? -1 : _RB < _RA ? 1 : 0;
+                }
+
+        const bool _ZA = _M::_IsZero(_A._Coeff), _ZB = _M::_IsZero(_B._Coeff);
+        if (_ZA && _ZB)
+                { return 0; }
+        if (_ZA)
+                { return _B._Sign ? 1 : -1; }
+        if (_ZB || _A._Sign != _B._Sign)
+                { return _A._Sign ? -1 : 1; }
+        const int _C = _CompareMagnitudes<_M>(_A._Coeff, _A._Exp, _B._Coeff,
+                                              _B._Exp);
+        return _A._Sign ? -_C : _C;
+        }
+
+int _WorkCompare(const _Native64 & _A, const _Native64 & _B)
+        { return _Compare<_KernelFmt<decimal64> >(_A, _B); }
+
+int _WorkCompare(const _Native128 & _A, const _Native128 & _B)
+        { return _Compare<_KernelFmt<decimal128> >(_A, _B); }
+
+} // namespace decimal
+} // namespace std
@@ -0,0 +1,292 @@
+/* ------------------------------------------------------------------ */
+/* decZoned.cpp source file                                           */
+/* ------------------------------------------------------------------ */
+/* Copyright (c) IBM Corporation, 2006.  All rights reserved.         */
+/*                                                                    */
+/* This software is made available under the terms of the IBM         */
+/* alphaWorks License Agreement (distributed with this software as    */
+/* alphaWorks-License.txt).  Your use of this software indicates      */
+/* your acceptance of the terms and conditions of that Agreement.     */
+/*                                                                    */
+/* Please send comments, suggestions, and corrections to the author:  */
+/*   klarer@ca.ibm.com                                                */
+/*   Robert Klarer                                                    */
+/* ------------------------------------------------------------------ */
+
+#include <cstring>
+
+#include "deczoned"
+#include "impl/decBCD.h"
+
+namespace std {
+namespace decimal {
+
+// longest field: its 45 digits still fit in a _DecNumber
+static const std::size_t _MaxZonedLength = 45;
+
+// Reads the digits of a zoned field into 12-bit BCD groups, least
+// significant first.  Returns 0 for a positive value, 1 for a negative
+// one, or -1 if a digit or the sign is invalid.
+static int _ReadZoned(const uint8_t * _F, std::size_t _Length,
+                      zoned_charset _Charset, unsigned * _G)
+        {
+        for (int _K = 0; _K != _MaxGroups; ++_K)
+                { _G[_K] = 0; }
+
+        const uint8_t * _P = _F + _Length - 1;
+        const unsigned _B = *_P;
+        unsigned _D;
+        int _Sign;
+        if (_Charset == zoned_ebcdic)
+                {
+                _D = _B & 0xF;
+                switch (_B >> 4)
+                        {
+                        case 0xA: case 0xC: case 0xE: case 0xF:
+                                _Sign = 0;
+                                break;
+                        case 0xB: case 0xD:
+                                _Sign = 1;
+                                break;
+                        default:
+                                return -1;
+                        }
+                }
+        else if (_B - '0' <= 9U)
+                {
+                _D = _B - '0';
+                _Sign = 0;
+                }
+        else if (_B - 'p' <= 9U)
+                {
+                _D = _B - 'p';
+                _Sign = 1;
+                }
+        else if (_B == '{' || _B == '}')
+                {
+                _D = 0;
+                _Sign = _B == '}';
+                }
+        else if (_B - 'A' <= 8U)
+                {
+                _D = _B - 'A' + 1;
+                _Sign = 0;
+                }
+        else if (_B - 'J' <= 8U)
+                {
+                _D = _B - 'J' + 1;
+                _Sign = 1;
+                }
+        else
+                { return -1; }
+        if (_D > 9)
+                { return -1; }
+        _G[0] = _D;
+
+        const unsigned _Zone = _Charset == zoned_ebcdic ? 0xF0 : 0x30;
+        for (std::size_t _J = 1; _P != _F; ++_J)
+                {
+                --_P;
+                const unsigned _Dj = *_P - _Zone;
+                if (_Dj > 9)
+                        { return -1; }
+                _G[_J / 3] |= _Dj << (4 * (_J % 3));
+                }
+        return _Sign;
+        }
+
+// Writes the _NG groups of _G, shifted left by _Shift digits, to a
+// zoned field.  The caller ensures that the digits fit.
+static void _WriteZoned(uint8_t * _F, std::size_t _Length,
+                        zoned_charset _Charset, unsigned _Sign,
+                        std::size_t _Shift, const unsigned * _G, int _NG)
+        {
+        const unsigned _Zone = _Charset == zoned_ebcdic ? 0xF0 : 0x30;
+        memset(_F, _Zone, _Length);
+        for (int _K = 0; _K != _NG; ++_K)
+                {
+                unsigned _B = _G[_K];
+                for (std::size_t _J = _Shift + 3 * _K; _B != 0; ++_J, _B >>= 4)
+                        {
+                        _F[_Length - 1 - _J] =
+                                static_cast<uint8_t>(_Zone | (_B & 0xF));
+                        }
+                }
+
+        uint8_t & _Last = _F[_Length - 1];
+        const unsigned _SignZone = _Charset == zoned_ebcdic ?
+                                   (_Sign ? 0xD0 : 0xC0) :
+                                   (_Sign ? 0x70 : 0x30);
+        _Last = static_cast<uint8_t>(_SignZone | (_Last & 0xF));
+        }
+
+static void _WriteZonedZero(uint8_t * _F, std::size_t _Length,
+                            zoned_charset _Charset)
+        {
+        const unsigned _Zero = 0;
+        _WriteZoned(_F, _Length, _Charset, 0, 0, &_Zero, 1);
+        }
+
+// the general conversions, through decNumber
+template <class _Fmt>
+static uint32_t _FromZonedViaNumber(const unsigned * _G, unsigned _Sign,
+                                    int _Scale, _Fmt & _V)
+        {
+        typedef _FmtTraits<_Fmt> _Tr;
+        typename _Tr::_Context _Ctxt(false);
+        _DecNumber _N;
+        _GroupsToNumber(_G, _MaxGroups, _Sign, -_Scale, _N);
+        _Tr::_FromNumber(&_V, _N, &_Ctxt);
+        return _Ctxt.status;
+        }
+
+template <class _Fmt>
+static uint32_t _ToZonedViaNumber(const _Fmt & _V, uint8_t * _F,
+                                  std::size_t _Length, int _Scale,
+                                  zoned_charset _Charset)
+        {
+        typename _FmtTraits<_Fmt>::_Context _Ctxt(false);
+        _Ctxt.digits = static_cast<int32_t>(_Length);
+        const _DecNumber _N(_V);
+        const _DecNumber _Q(static_cast<long long>(-_Scale));
+        _DecNumber _R;
+        decNumberRescale(&_R, &_N, &_Q, &_Ctxt);
+
+        unsigned _G[_MaxGroups];
+        if (decNumberIsNaN(&_R) || !_NumberToGroups(_R, _G, _MaxGroups))
+                {
+                _WriteZonedZero(_F, _Length, _Charset);
+                return _Ctxt.status | DEC_Invalid_operation;
+                }
+        _WriteZoned(_F, _Length, _Charset, decNumberIsNegative(&_R) ? 1 : 0,
+                    0, _G, _MaxGroups);
+        return _Ctxt.status;
+        }
+
+template <class _Fmt>
+static uint32_t _FromZoned(const uint8_t * _In, std::size_t _Count,
+                           std::size_t _Length, int _Scale, _Fmt * _Out,
+                           zoned_charset _Charset, std::size_t _Stride)
+        {
+        typedef _BCDFmt<_Fmt> _P;
+        if (_Length == 0 || _Length > _MaxZonedLength)
+                { return DEC_Invalid_operation; }
+        if (_Stride == 0)
+                { _Stride = _Length; }
+
+        // the exponent of every field, if it is in range
+        const long _E = _P::_Bias - static_cast<long>(_Scale);
+        const bool _ExpOk = _E >= 0 && _E < (3L << _P::_ExpCont);
+
+        uint32_t _Status = 0;
+        unsigned _G[_MaxGroups], _Dec[_P::_Declets];
+        for (std::size_t _I = 0; _I != _Count; ++_I, _In += _Stride)
+                {
+                const int _Sign = _ReadZoned(_In, _Length, _Charset, _G);
+                if (_Sign < 0)
+                        {
+                        _Out[_I] = _Fmt::_GetNAN();
+                        _Status |= DEC_Conversion_syntax;
+                        continue;
+                        }
+
+                bool _Fits = _ExpOk && _G[_P::_Declets] <= 9;
+                for (int _K = _P::_Declets + 1; _K < _MaxGroups; ++_K)
+                        { _Fits = _Fits && _G[_K] == 0; }
+                if (!_Fits)
+                        {
+                        _Status |= _FromZonedViaNumber(_G, _Sign, _Scale,
+                                                       _Out[_I]);
+                        continue;
+                        }
+
+                for (int _K = 0; _K != _P::_Declets; ++_K)
+                        { _Dec[_K] = BCD2DPD[_G[_K]]; }
+                _Assemble(_Out[_I], _Sign, _G[_P::_Declets],
+                          static_cast<unsigned>(_E), _Dec);
+                }
+        return _Status;
+        }
+
+template <class _Fmt>
+static uint32_t _ToZoned(const _Fmt * _In, std::size_t _Count,
+                         uint8_t * _Out, std::size_t _Length, int _Scale,
+                         zoned_charset _Charset, std::size_t _Stride)
+        {
+        typedef _BCDFmt<_Fmt> _P;
+        if (_Length == 0 || _Length > _MaxZonedLength)
+                { return DEC_Invalid_operation; }
+        if (_Stride == 0)
+                { _Stride = _Length; }
+
+        uint32_t _Status = 0;
+        unsigned _G[_P::_Declets + 1];
+        for (std::size_t _I = 0; _I != _Count; ++_I, _Out += _Stride)
+                {
+                unsigned _Sign;
+                int _Exp;
+                if (!_Disassemble(_In[_I], _Sign, _Exp, _G))
+                        {
+                        _WriteZonedZero(_Out, _Length, _Charset);
+                        _Status |= DEC_Invalid_operation;
+                        continue;
+                        }
+
+                // a value with more fraction digits than the field must
+                // be rounded
+                const long _Shift = static_cast<long>(_Exp) + _Scale;
+                if (_Shift < 0)
+                        {
+                        _Status |= _ToZonedViaNumber(_In[_I], _Out, _Length,
+                                                     _Scale, _Charset);
+                        continue;
+                        }
+
+                const std::size_t _Sig = _SigDigits(_G, _P::_Declets + 1);
+                if (_Sig != 0 && _Sig + _Shift > _Length)
+                        {
+                        _WriteZonedZero(_Out, _Length, _Charset);
+                        _Status |= DEC_Invalid_operation;
+                        continue;
+                        }
+
+                _WriteZoned(_Out, _Length, _Charset, _Sign,
+                            _Sig != 0 ? _Shift : 0, _G, _P::_Declets + 1);
+                }
+        return _Status;
+        }
+
+uint32_t from_zoned(const uint8_t * _In, std::size_t _Count,
+                    std::size_t _Length, int _Scale, decimal64 * _Out,
+                    zoned_charset _Charset, std::size_t _Stride)
+        {
+        return _FromZoned(_In, _Count, _Length, _Scale, _Out,
+                          _Charset, _Stride);
+        }
+
+uint32_t from_zoned(const uint8_t * _In, std::size_t _Count,
+                    std::size_t _Length, int _Scale, decimal128 * _Out,
+                    zoned_charset _Charset, std::size_t _Stride)
+        {
+        return _FromZoned(_In, _Count, _Length, _Scale, _Out,
+                          _Charset, _Stride);
+        }
+
+uint32_t to_zoned(const decimal64 * _In, std::size_t _Count,
+                  uint8_t * _Out, std::size_t _Length, int _Scale,
+                  zoned_charset _Charset, std::size_t _Stride)
+        {
+        return _ToZoned(_In, _Count, _Out, _Length, _Scale,
+                        _Charset, _Stride);
+        }
+
+uint32_t to_zoned(const decimal128 * _In, std::size_t _Count,
+                  uint8_t * _Out, std::size_t _Length, int _Scale,
+                  zoned_charset _Charset, std::size_t _Stride)
+        {
+        return _ToZoned(_In, _Count, _Out, _Length, _Scale,
+                        _Charset, _Stride);
+        }
+
+} // namespace decimal
+} // namespace std